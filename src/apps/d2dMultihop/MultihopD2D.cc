@@ -12,7 +12,6 @@
 #include <inet/common/packet/chunk/ByteCountChunk.h>
 #include <inet/common/TimeTag_m.h>
 #include "apps/d2dMultihop/MultihopD2D.h"
-#include "apps/d2dMultihop/TrickleTimerMsg_m.h"
 #include "apps/d2dMultihop/MultihopD2DPacket_m.h"
 #include "stack/mac/layer/LteMacBase.h"
 #include "inet/common/ModuleAccess.h"  // for multicast support
@@ -25,7 +24,8 @@ using namespace inet;
 
 uint16_t MultihopD2D::numMultihopD2DApps = 0;
 
-MultihopD2D::MultihopD2D()
+MultihopD2D::MultihopD2D() :
+    timerWheel_(this), trickleTimer_(&timerWheel_)
 {
     senderAppId_ = numMultihopD2DApps++;
     selfSender_ = nullptr;
@@ -36,14 +36,10 @@ MultihopD2D::~MultihopD2D()
 {
     cancelAndDelete(selfSender_);
 
-    if (trickleEnabled_)
-    {
-        std::map<unsigned int, inet::Packet*>::iterator it = last_.begin();
-        for (; it != last_.end(); ++it)
-            if (it->second != nullptr)
-                delete it->second;
-        last_.clear();
-    }
+    std::unordered_map<uint32_t, TrickleState>::iterator it = trickleState_.begin();
+    for (; it != trickleState_.end(); ++it)
+        delete it->second.last;
+    trickleState_.clear();
 }
 
 void MultihopD2D::initialize(int stage)
@@ -77,6 +73,11 @@ void MultihopD2D::initialize(int stage)
                 throw cRuntimeError("Bad value for k. It must be greater than zero");
         }
 
+        duplicateWindow_ = par("duplicateFilterWindow");
+        if (trickleEnabled_ && duplicateWindow_ > 0 && duplicateWindow_ <= I_)
+            throw cRuntimeError("Bad value for duplicateFilterWindow. It must be greater than I");
+        windowEnd_ = NOW + duplicateWindow_;
+
         EV << "MultihopD2D::initialize - binding to port: local:" << localPort_ << " , dest:" << destPort_ << endl;
         socket.setOutputGate(gate("socketOut"));
         socket.bind(localPort_);
@@ -120,14 +121,21 @@ void MultihopD2D::initialize(int stage)
 
 void MultihopD2D::handleMessage(cMessage *msg)
 {
-    if (msg->isSelfMessage())
+    if (timerWheel_.isTimerMessage(msg))
+    {
+        // the timer message is owned by the wheel
+        unsigned int timerId, event;
+        while (timerWheel_.popExpired(timerId, event))
+        {
+            handleTrickleTimer(event);
+        }
+    }
+    else if (msg->isSelfMessage())
     {
         if (!strcmp(msg->getName(), "selfSender"))
             sendPacket();
         else if (!strcmp(msg->getName(), "MultihopD2DPacket"))
             relayPacket(msg);
-        else if (!strcmp(msg->getName(), "trickleTimer"))
-            handleTrickleTimer(msg);
         else
             throw cRuntimeError("Unrecognized self message");
     }
@@ -218,11 +226,16 @@ void MultihopD2D::handleRcvdPacket(cMessage* msg)
     // check if this is a duplicate
     if (isAlreadyReceived(msgId))
     {
-        if (trickleEnabled_)
-            counter_[msgId]++;
+        // count the duplicate, if the Trickle interval of the message is running
+        std::unordered_map<uint32_t, TrickleState>::iterator it = trickleState_.find(msgId);
+        if (it != trickleState_.end())
+        {
+            it->second.counter++;
+            EV << "MultihopD2D::handleRcvdPacket - Trickle interval running, counter = " << it->second.counter << endl;
+        }
 
         // do not need to relay the message again
-        EV << "MultihopD2D::handleRcvdPacket - The message has already been received, counter = " << counter_[msgId] << endl;
+        EV << "MultihopD2D::handleRcvdPacket - The message has already been received" << endl;
 
         emit(d2dMultihopRcvdDupMsg_, (long)1);
         stat_->recordDuplicateReception(msgId);
@@ -235,19 +248,6 @@ void MultihopD2D::handleRcvdPacket(cMessage* msg)
         // mark the message as received
         markAsReceived(msgId);
 
-        if (trickleEnabled_)
-        {
-            counter_[msgId] = 1;
-
-            // store a copy of the packet
-            if (last_.find(msgId) != last_.end() && last_[msgId] != nullptr)
-            {
-                delete last_[msgId];
-                last_[msgId] = nullptr;
-            }
-            last_[msgId] = pPacket->dup();
-        }
-
         // emit statistics
         simtime_t delay = simTime() - mhop->getPayloadTimestamp();
         emit(d2dMultihopRcvdMsg_, (long)1);
@@ -277,16 +277,17 @@ void MultihopD2D::handleRcvdPacket(cMessage* msg)
         {
             if (trickleEnabled_)
             {
-                // start Trickle interval timer
-                TrickleTimerMsg* timer = new TrickleTimerMsg("trickleTimer");
-                timer->setMsgid(msgId);
+                // keep the packet until the end of the Trickle interval
+                TrickleState& state = trickleState_[msgId];
+                state.last = pPacket;
+                state.counter = 1;
 
+                // start Trickle interval timer
                 simtime_t t = uniform(I_/2 , I_);
                 t = round(SIMTIME_DBL(t)*1000)/1000;
                 EV << "MultihopD2D::handleRcvdPacket - start Trickle interval, duration[" << t << "s]" << endl;
 
-                scheduleAt(simTime() + t, timer);
-                delete pPacket;
+                trickleTimer_.add(t, msgId);
             }
             else
             {
@@ -303,22 +304,27 @@ void MultihopD2D::handleRcvdPacket(cMessage* msg)
     }
 }
 
-void MultihopD2D::handleTrickleTimer(cMessage* msg)
+void MultihopD2D::handleTrickleTimer(uint32_t msgId)
 {
-    TrickleTimerMsg* timer = check_and_cast<TrickleTimerMsg*>(msg);
-    unsigned int msgId = timer->getMsgid();
-    if (counter_[msgId] < k_)
+    std::unordered_map<uint32_t, TrickleState>::iterator it = trickleState_.find(msgId);
+    if (it == trickleState_.end())
+        throw cRuntimeError("MultihopD2D::handleTrickleTimer - no Trickle state for msg %u", msgId);
+
+    TrickleState state = it->second;
+    trickleState_.erase(it);
+
+    if (state.counter < k_)
     {
-        EV << "MultihopD2D::handleTrickleTimer - relay the message, counter[" << counter_[msgId] << "] k[" << k_ << "]" << endl;
-        relayPacket(last_[msgId]->dup());
+        EV << "MultihopD2D::handleTrickleTimer - relay the message, counter[" << state.counter << "] k[" << k_ << "]" << endl;
+        relayPacket(state.last);
     }
     else
     {
-        EV << "MultihopD2D::handleTrickleTimer - suppressed message, counter[" << counter_[msgId] << "] k[" << k_ << "]" << endl;
+        EV << "MultihopD2D::handleTrickleTimer - suppressed message, counter[" << state.counter << "] k[" << k_ << "]" << endl;
         stat_->recordSuppressedMessage(msgId);
         emit(d2dMultihopTrickleSuppressedMsg_, (long)1);
+        delete state.last;
     }
-    delete msg;
 }
 
 
@@ -370,39 +376,67 @@ void MultihopD2D::relayPacket(cMessage* msg)
     delete pPacket;
 }
 
+void MultihopD2D::rotateDuplicateFilter()
+{
+    if (duplicateWindow_ <= 0 || NOW < windowEnd_)
+        return;
+
+    if (NOW >= windowEnd_ + duplicateWindow_)
+    {
+        // all the stored ids are older than one window
+        oldRelayedMsgMap_.clear();
+        relayedMsgMap_.clear();
+        windowEnd_ = NOW + duplicateWindow_;
+    }
+    else
+    {
+        // the current window becomes the previous one
+        oldRelayedMsgMap_.swap(relayedMsgMap_);
+        relayedMsgMap_.clear();
+        windowEnd_ += duplicateWindow_;
+    }
+}
+
 void MultihopD2D::markAsReceived(uint32_t msgId)
 {
+    rotateDuplicateFilter();
     std::pair<uint32_t,bool> p(msgId,false);
     relayedMsgMap_.insert(p);
 }
 
 bool MultihopD2D::isAlreadyReceived(uint32_t msgId)
 {
-    if (relayedMsgMap_.find(msgId) == relayedMsgMap_.end())
+    rotateDuplicateFilter();
+    if (relayedMsgMap_.find(msgId) == relayedMsgMap_.end() && oldRelayedMsgMap_.find(msgId) == oldRelayedMsgMap_.end())
         return false;
     return true;
 }
 
 void MultihopD2D::markAsRelayed(uint32_t msgId)
 {
+    rotateDuplicateFilter();
     relayedMsgMap_[msgId] = true;
+    oldRelayedMsgMap_.erase(msgId);
 }
 
 bool MultihopD2D::isAlreadyRelayed(uint32_t msgId)
 {
-    if (relayedMsgMap_.find(msgId) == relayedMsgMap_.end()) // the message has not been received
-        return false;
-    if (!relayedMsgMap_[msgId])    // the message has been received but not relayed yet
-        return false;
-
-    return true;
+    rotateDuplicateFilter();
+    std::unordered_map<uint32_t,bool>::iterator it = relayedMsgMap_.find(msgId);
+    if (it == relayedMsgMap_.end())
+    {
+        it = oldRelayedMsgMap_.find(msgId);
+        if (it == oldRelayedMsgMap_.end()) // the message has not been received
+            return false;
+    }
+    return it->second;    // false if the message has been received but not relayed yet
 }
 
-bool MultihopD2D::isWithinBroadcastArea(Coord srcCoord, double maxRadius)
+bool MultihopD2D::isWithinBroadcastArea(const Coord& srcCoord, double maxRadius)
 {
-    Coord myCoord = ltePhy_->getCoord();
-    double dist = myCoord.distance(srcCoord);
-    if (dist < maxRadius)
+    // compare squared distances, to avoid the square root
+    const Coord& myCoord = ltePhy_->getCoord();
+    if (myCoord.sqrdist(srcCoord) < maxRadius * maxRadius)
         return true;
 
     return false;
@@ -11,10 +11,12 @@
 #define _LTE_MULTIHOPD2D_H_
 
 #include <string.h>
+#include <unordered_map>
 #include <omnetpp.h>
 #include <inet/transportlayer/contract/udp/UdpSocket.h>
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include "common/LteCommon.h"
+#include "common/timer/TTimerWheel.h"
 #include "apps/d2dMultihop/MultihopD2DPacket_m.h"
 #include "apps/d2dMultihop/statistics/MultihopD2DStatistics.h"
 #include "apps/d2dMultihop/eventGenerator/EventGenerator.h"
@@ -43,11 +45,27 @@ protected:
     bool trickleEnabled_;
     unsigned int k_;
     omnetpp::simtime_t I_;
-    std::map<unsigned int, inet::Packet*> last_;
-    std::map<unsigned int, unsigned int> counter_;
+
+    // state of a message whose Trickle interval is running
+    struct TrickleState
+    {
+        inet::Packet* last;       // copy of the received message, to be relayed
+        unsigned int counter;     // number of receptions of the message
+    };
+    std::unordered_map<uint32_t, TrickleState> trickleState_;
+
+    // all the Trickle intervals of the node are served by a single timer (event id is the msg id)
+    TTimerWheel timerWheel_;
+    TWheelMultiTimer trickleTimer_;
     /***************************************************/
 
-    std::map<uint32_t,bool> relayedMsgMap_;  // indicates if a received message has been relayed before
+    // duplicate filter: ids of the messages received in the current and in the previous window,
+    // each one associated to a flag indicating if the message has been relayed before.
+    // Ids are remembered for at least duplicateWindow_, so that memory does not grow over time
+    std::unordered_map<uint32_t,bool> relayedMsgMap_;
+    std::unordered_map<uint32_t,bool> oldRelayedMsgMap_;
+    omnetpp::simtime_t duplicateWindow_;    // if <= 0, ids are never forgotten
+    omnetpp::simtime_t windowEnd_;
 
     int localPort_;
     int destPort_;
@@ -76,15 +94,16 @@ protected:
     virtual void handleMessage(omnetpp::cMessage *msg);
     virtual void finish();
 
+    void rotateDuplicateFilter();             // forget the ids of the messages received before the previous window
     void markAsReceived(uint32_t msgId);      // store the msg id in the set of received messages
     bool isAlreadyReceived(uint32_t msgId);   // returns true if the given msg has already been received
     void markAsRelayed(uint32_t msgId);       // set the corresponding entry in the set as relayed
     bool isAlreadyRelayed(uint32_t msgId);   // returns true if the given msg has already been relayed
-    bool isWithinBroadcastArea(inet::Coord srcCoord, double maxRadius);
+    bool isWithinBroadcastArea(const inet::Coord& srcCoord, double maxRadius);
 
     virtual void sendPacket();
     virtual void handleRcvdPacket(omnetpp::cMessage* msg);
-    virtual void handleTrickleTimer(omnetpp::cMessage* msg);
+    virtual void handleTrickleTimer(uint32_t msgId);
     virtual void relayPacket(omnetpp::cMessage* msg);
 
   public:
@@ -0,0 +1,170 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include <inet/common/ModuleAccess.h>
+
+#include "apps/fluid/FluidTrafficSource.h"
+#include "corenetwork/binder/LteBinder.h"
+#include "stack/mac/layer/LteMacBase.h"
+
+Define_Module(FluidTrafficSource);
+
+using namespace omnetpp;
+
+simsignal_t FluidTrafficSource::fluidGeneratedBytesSignal_ = registerSignal("fluidGeneratedBytes");
+simsignal_t FluidTrafficSource::fluidDroppedBytesSignal_ = registerSignal("fluidDroppedBytes");
+
+FluidTrafficSource::FluidTrafficSource()
+{
+    creditTimer_ = nullptr;
+    switchTimer_ = nullptr;
+}
+
+FluidTrafficSource::~FluidTrafficSource()
+{
+    cancelAndDelete(creditTimer_);
+    cancelAndDelete(switchTimer_);
+}
+
+void FluidTrafficSource::initialize(int stage)
+{
+    cSimpleModule::initialize(stage);
+
+    if (stage == inet::INITSTAGE_LOCAL)
+    {
+        creditTimer_ = new cMessage("creditTimer");
+        switchTimer_ = new cMessage("switchTimer");
+
+        rate_ = par("rate").doubleValue() / 8;
+        creditInterval_ = par("creditInterval");
+        if (creditInterval_ <= 0)
+            throw cRuntimeError("FluidTrafficSource::initialize - creditInterval must be positive");
+        finishTime_ = par("finishTime");
+        onDuration_ = &par("onDuration");
+        offDuration_ = &par("offDuration");
+        residualCredit_ = 0;
+
+        std::string dir = par("direction").stdstringValue();
+        if (dir != "DL" && dir != "UL")
+            throw cRuntimeError("FluidTrafficSource::initialize - unknown direction %s", dir.c_str());
+
+        int flowId = par("flowId");
+        if (flowId < 0)
+            flowId = getIndex();
+
+        flowInfo_.setDirection(dir == "DL" ? DL : UL);
+        flowInfo_.setLcid(FLUID_LCID_BASE + flowId);
+        flowInfo_.setTraffic(aToLteTrafficClass(par("trafficClass").stdstringValue()));
+        flowInfo_.setApplication(UNKNOWN_APP);
+        flowInfo_.setRlcType(UM);
+    }
+    else if (stage == inet::INITSTAGE_APPLICATION_LAYER)
+    {
+        binder_ = getBinder();
+        // the UE has been registered to the binder at link layer initialization
+        nodeId_ = inet::getContainingNode(this)->par("macNodeId");
+
+        simtime_t startTime = par("startTime");
+        scheduleAt(std::max(startTime, simTime()), switchTimer_);
+    }
+}
+
+void FluidTrafficSource::handleMessage(cMessage *msg)
+{
+    if (!msg->isSelfMessage())
+    {
+        // nothing is expected from the sockets
+        delete msg;
+        return;
+    }
+
+    if (msg == creditTimer_)
+    {
+        addCredit();
+        if (finishTime_ > 0 && simTime() + creditInterval_ > finishTime_)
+            switchOff();
+        else
+            scheduleAt(simTime() + creditInterval_, creditTimer_);
+    }
+    else if (msg == switchTimer_)
+    {
+        if (creditTimer_->isScheduled())
+            switchOff();
+        else
+            switchOn();
+    }
+}
+
+void FluidTrafficSource::switchOn()
+{
+    if (finishTime_ > 0 && simTime() >= finishTime_)
+        return;
+
+    EV << "FluidTrafficSource::switchOn - node " << nodeId_ << endl;
+
+    lastUpdate_ = simTime();
+    scheduleAt(simTime() + creditInterval_, creditTimer_);
+
+    simtime_t on = onDuration_->doubleValue();
+    if (on > 0)
+        scheduleAt(simTime() + on, switchTimer_);
+}
+
+void FluidTrafficSource::switchOff()
+{
+    EV << "FluidTrafficSource::switchOff - node " << nodeId_ << endl;
+
+    cancelEvent(creditTimer_);
+    cancelEvent(switchTimer_);
+    addCredit();
+
+    simtime_t off = offDuration_->doubleValue();
+    if (onDuration_->doubleValue() > 0 && (finishTime_ == 0 || simTime() < finishTime_))
+        scheduleAt(simTime() + off, switchTimer_);
+}
+
+void FluidTrafficSource::addCredit()
+{
+    residualCredit_ += rate_ * (simTime() - lastUpdate_).dbl();
+    lastUpdate_ = simTime();
+
+    unsigned int bytes = (unsigned int) residualCredit_;
+    if (bytes == 0)
+        return;
+    residualCredit_ -= bytes;
+
+    emit(fluidGeneratedBytesSignal_, (long)bytes);
+
+    LteMacBase* mac = getFedMac();
+    unsigned int accepted = (mac != nullptr) ? mac->bufferizeFluidData(flowInfo_, bytes) : 0;
+
+    EV << "FluidTrafficSource::addCredit - node " << nodeId_ << " lcid " << flowInfo_.getLcid() << ": "
+       << bytes << " bytes generated, " << accepted << " bytes buffered" << endl;
+
+    if (accepted < bytes)
+        emit(fluidDroppedBytesSignal_, (long)(bytes - accepted));
+}
+
+LteMacBase* FluidTrafficSource::getFedMac()
+{
+    // the serving cell is looked up at each update, so that the flow follows handovers
+    MacNodeId cellId = binder_->getNextHop(nodeId_);
+    if (cellId == 0)
+        return nullptr;
+
+    if (flowInfo_.getDirection() == DL)
+    {
+        flowInfo_.setSourceId(cellId);
+        flowInfo_.setDestId(nodeId_);
+        return binder_->getMacFromMacNodeId(cellId);
+    }
+    flowInfo_.setSourceId(nodeId_);
+    flowInfo_.setDestId(cellId);
+    return binder_->getMacFromMacNodeId(nodeId_);
+}
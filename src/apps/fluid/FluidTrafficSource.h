@@ -0,0 +1,79 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _FLUIDTRAFFICSOURCE_H_
+#define _FLUIDTRAFFICSOURCE_H_
+
+#include <omnetpp.h>
+
+#include <inet/common/INETDefs.h>
+
+#include "common/LteCommon.h"
+#include "common/LteControlInfo.h"
+
+class LteBinder;
+class LteMacBase;
+
+/**
+ * Aggregate traffic source: feeds the MAC buffer of a connection with byte
+ * credit, at a given rate while an on/off process is on.
+ * See FluidTrafficSource.ned
+ */
+class SIMULTE_API FluidTrafficSource : public omnetpp::cSimpleModule
+{
+    LteBinder* binder_;
+
+    // id of the UE hosting this source
+    MacNodeId nodeId_;
+
+    // descriptor of the fed connection (the eNB side is set at each credit update)
+    FlowControlInfo flowInfo_;
+
+    // offered rate, in bytes per second
+    double rate_;
+    omnetpp::simtime_t creditInterval_;
+    omnetpp::simtime_t finishTime_;
+
+    omnetpp::cPar* onDuration_;
+    omnetpp::cPar* offDuration_;
+
+    // fraction of byte left over by the last credit update
+    double residualCredit_;
+    // time of the last credit update (or of the start of the on period)
+    omnetpp::simtime_t lastUpdate_;
+
+    // timers
+    omnetpp::cMessage* creditTimer_;
+    omnetpp::cMessage* switchTimer_;
+
+    static omnetpp::simsignal_t fluidGeneratedBytesSignal_;
+    static omnetpp::simsignal_t fluidDroppedBytesSignal_;
+
+  public:
+    FluidTrafficSource();
+    ~FluidTrafficSource();
+
+  protected:
+    virtual int numInitStages() const override { return inet::NUM_INIT_STAGES; }
+    virtual void initialize(int stage) override;
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+
+    // starts an on period (of infinite length, if no on/off process is configured)
+    void switchOn();
+    // ends the on period, adding the credit accumulated so far
+    void switchOff();
+
+    // adds the credit accumulated since the last update to the MAC buffer
+    void addCredit();
+
+    // returns the MAC hosting the buffer of the connection (nullptr if the UE is not attached)
+    LteMacBase* getFedMac();
+};
+
+#endif
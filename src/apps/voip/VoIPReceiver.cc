@@ -14,21 +14,6 @@ Define_Module(VoIPReceiver);
 using namespace std;
 using namespace inet;
 
-VoIPReceiver::~VoIPReceiver()
-{
-    while (!mPlayoutQueue_.empty())
-    {
-        delete mPlayoutQueue_.front();
-        mPlayoutQueue_.pop_front();
-    }
-
-    while (!mPacketsList_.empty())
-    {
-        delete mPacketsList_.front();
-        mPacketsList_.pop_front();
-    }
-}
-
 void VoIPReceiver::initialize(int stage)
 {
     if (stage != inet::INITSTAGE_APPLICATION_LAYER)
@@ -43,6 +28,10 @@ void VoIPReceiver::initialize(int stage)
     mSamplingDelta_ = par("sampling_time");
     mPlayoutDelay_ = par("playout_delay");
 
+    mPlayoutRing_.resize(mBufferSpace_);
+    mPlayoutHead_ = 0;
+    mTalkspurtFrames_ = 0;
+
     mInit_ = true;
 
     int port = par("localPort");
@@ -104,127 +93,115 @@ void VoIPReceiver::handleMessage(cMessage *msg)
     }
 
 
-    auto packetToBeQueued = voipHeader->dup();
-    packetToBeQueued->setArrivalTime(simTime());
-    mPacketsList_.push_back(packetToBeQueued);
+    playoutFrame(voipHeader.get());
 
     delete pPacket;
 }
 
-void VoIPReceiver::playout(bool finish)
+void VoIPReceiver::playoutFrame(const VoipPacket* pPacket)
 {
-    if (mPacketsList_.empty())
-        return;
+    // frames are processed in order of arrival, as they are received
+    simtime_t arrivalTime = simTime();
 
-    double sample;
+    if (mTalkspurtFrames_ == 0)
+    {
+        // first frame of the talkspurt
+        mTalkspurtFrames_ = pPacket->getNframes();
+        mFirstPlayoutTime_ = arrivalTime + mPlayoutDelay_;
+        mReceivedFrames_ = 0;
+        mMaxFrameId_ = 0;
+        mPlayoutLoss_ = 0;
+        mTailDropLoss_ = 0;
+        mMaxJitter_ = -1000.0;
+        mIsArrived_.assign(mTalkspurtFrames_, false);
+        mFrameDelays_.clear();
+        mLateJitters_.clear();
+    }
 
-    VoipPacket* pPacket = mPacketsList_.front();
+    unsigned int IDframe = pPacket->getIDframe();
+    ++mReceivedFrames_;
+    mMaxFrameId_ = std::max(mMaxFrameId_, IDframe);
 
-    simtime_t firstPlayoutTime = pPacket->getArrivalTime() + mPlayoutDelay_;
-    unsigned int n_frames = pPacket->getNframes();
-    unsigned int playoutLoss = 0;
-    unsigned int tailDropLoss = 0;
-    unsigned int channelLoss;
+    mFrameDelays_.push_back(SIMTIME_DBL(arrivalTime - pPacket->getPayloadTimestamp()));
 
-    if (finish)
-    {
-        PacketsList::iterator it;
-        unsigned int maxId = 0;
-        for (it = mPacketsList_.begin(); it != mPacketsList_.end(); it++)
-            maxId = std::max(maxId, (*it)->getIDframe());
-        channelLoss = maxId + 1 - mPacketsList_.size();
-    }
+    simtime_t playoutTime = mFirstPlayoutTime_ + IDframe * mSamplingDelta_;
 
-    else
-        channelLoss = pPacket->getNframes() - mPacketsList_.size();
+    simtime_t jitter = arrivalTime - playoutTime;
+    mMaxJitter_ = std::max(mMaxJitter_, jitter);
 
-    sample = ((double) channelLoss / (double) n_frames);
-    emit(voIPFrameLossSignal_, sample);
+    EV << "VoIPReceiver::playoutFrame - Jitter measured: " << jitter << " TALK[" << pPacket->getIDtalk() << "] - FRAME[" << IDframe << "]\n";
 
-    //Vector for managing duplicates
-    bool* isArrived = new bool[pPacket->getNframes()];
-    for (unsigned int y = 0; y < pPacket->getNframes(); y++)
+    //Duplicates management
+    if (mIsArrived_[IDframe])
     {
-        isArrived[y] = false;
+        EV << "VoIPReceiver::playoutFrame - Duplicated Packet: TALK[" << pPacket->getIDtalk() << "] - FRAME[" << IDframe << "]\n";
     }
-
-    simtime_t last_jitter = 0.0;
-    simtime_t max_jitter = -1000.0;
-
-    while (!mPacketsList_.empty())
+    else if (jitter > 0.0)
     {
-        pPacket = mPacketsList_.front();
-
-        sample = SIMTIME_DBL(pPacket->getArrivalTime() - pPacket->getPayloadTimestamp());
-        emit(voIPFrameDelaySignal_, sample);
-
-        unsigned int IDframe = pPacket->getIDframe();
-
-        pPacket->setPlayoutTime(firstPlayoutTime + IDframe * mSamplingDelta_);
-
-        last_jitter = pPacket->getArrivalTime() - pPacket->getPlayoutTime();
-        max_jitter = std::max(max_jitter, last_jitter);
-
-        // avoid printing during finish (as it will print to the standard output)
-        if(!finish)
-            EV << "VoIPReceiver::playout - Jitter measured: " << last_jitter << " TALK[" << pPacket->getIDtalk() << "] - FRAME[" << pPacket->getIDframe() << "]\n";
-
-        //Duplicates management
-        if (isArrived[pPacket->getIDframe()])
+        ++mPlayoutLoss_;
+        EV << "VoIPReceiver::playoutFrame - out of time packet deleted: TALK[" << pPacket->getIDtalk() << "] - FRAME[" << IDframe << "]\n";
+        mLateJitters_.push_back(jitter);
+    }
+    else
+    {
+        // release the frames played out before this arrival, in insertion order
+        unsigned int capacity = mPlayoutRing_.size();
+        while (mBufferSpace_ < capacity && arrivalTime > mPlayoutRing_[mPlayoutHead_])
         {
-            // avoid printing during finish (as it will print to the standard output)
-            if(!finish)
-                EV << "VoIPReceiver::playout - Duplicated Packet: TALK[" << pPacket->getIDtalk() << "] - FRAME[" << pPacket->getIDframe() << "]\n";
-            delete pPacket;
+            ++mBufferSpace_;
+            mPlayoutHead_ = (mPlayoutHead_ + 1) % capacity;
         }
-        else if( last_jitter > 0.0 )
+
+        if (mBufferSpace_ > 0)
         {
-            ++playoutLoss;
-            // avoid printing during finish (as it will print to the standard output)
-            if(!finish)
-                EV << "VoIPReceiver::playout - out of time packet deleted: TALK[" << pPacket->getIDtalk() << "] - FRAME[" << pPacket->getIDframe() << "]\n";
-            emit(voIPJitterSignal_, last_jitter);
-            delete pPacket;
+            EV << "VoIPReceiver::playoutFrame - Sampleable packet inserted into buffer: TALK["<< pPacket->getIDtalk() << "] - FRAME[" << IDframe
+               << "] - arrival time[" << arrivalTime << "] -  sampling time[" << playoutTime << "]\n";
+
+            unsigned int tail = (mPlayoutHead_ + capacity - mBufferSpace_) % capacity;
+            mPlayoutRing_[tail] = playoutTime;
+            --mBufferSpace_;
+
+            //duplicates management
+            mIsArrived_[IDframe] = true;
         }
         else
         {
-            while( !mPlayoutQueue_.empty() && pPacket->getArrivalTime() > mPlayoutQueue_.front()->getPlayoutTime() )
-            {
-                ++mBufferSpace_;
-                delete mPlayoutQueue_.front();
-                mPlayoutQueue_.pop_front();
-            }
-
-            if(mBufferSpace_ > 0)
-            {
-                // avoid printing during finish (as it will print to the standard output)
-                if(!finish)
-                {
-                    EV << "VoIPReceiver::playout - Sampleable packet inserted into buffer: TALK["<< pPacket->getIDtalk() << "] - FRAME[" << pPacket->getIDframe()
-                       << "] - arrival time[" << pPacket->getArrivalTime() << "] -  sampling time[" << pPacket->getPlayoutTime() << "]\n";
-                }
-                --mBufferSpace_;
-
-                //duplicates management
-                isArrived[pPacket->getIDframe()] = true;
-
-                mPlayoutQueue_.push_back(pPacket);
-            }
-            else
-            {
-                ++tailDropLoss;
-                // avoid printing during finish (as it will print to the standard output)
-                if(!finish)
-                {
-                    EV << "VoIPReceiver::playout - Buffer is full, discarding packet: TALK[" << pPacket->getIDtalk() << "] - FRAME["
-                       << pPacket->getIDframe() << "] - arrival time[" << pPacket->getArrivalTime() << "]\n";
-                }
-                delete pPacket;
-            }
+            ++mTailDropLoss_;
+            EV << "VoIPReceiver::playoutFrame - Buffer is full, discarding packet: TALK[" << pPacket->getIDtalk() << "] - FRAME["
+               << IDframe << "] - arrival time[" << arrivalTime << "]\n";
         }
-
-        mPacketsList_.pop_front();
     }
+}
+
+void VoIPReceiver::playout(bool finish)
+{
+    if (mTalkspurtFrames_ == 0)
+        return;
+
+    double sample;
+
+    unsigned int n_frames = mTalkspurtFrames_;
+    unsigned int playoutLoss = mPlayoutLoss_;
+    unsigned int tailDropLoss = mTailDropLoss_;
+    unsigned int channelLoss;
+
+    if (finish)
+        channelLoss = mMaxFrameId_ + 1 - mReceivedFrames_;
+    else
+        channelLoss = n_frames - mReceivedFrames_;
+
+    sample = ((double) channelLoss / (double) n_frames);
+    emit(voIPFrameLossSignal_, sample);
+
+    for (unsigned int i = 0; i < mFrameDelays_.size(); i++)
+        emit(voIPFrameDelaySignal_, mFrameDelays_[i]);
+    for (unsigned int i = 0; i < mLateJitters_.size(); i++)
+        emit(voIPJitterSignal_, mLateJitters_[i]);
+
+    simtime_t max_jitter = mMaxJitter_;
+
+    // the next frame starts a new talkspurt
+    mTalkspurtFrames_ = 0;
 
     double proportionalLoss = ((double) tailDropLoss + (double) playoutLoss + (double) channelLoss) / (double) n_frames;
     // avoid printing during finish (as it will print to the standard output)
@@ -262,8 +239,6 @@ void VoIPReceiver::playout(bool finish)
     // avoid printing during finish (as it will print to the standard output)
     if(!finish)
         EV << "\t New Playout Delay: " << mPlayoutDelay_ << "\n\n";
-
-    delete[] isArrived;
 }
 
 double VoIPReceiver::eModel(simtime_t delay, double loss)
@@ -10,8 +10,8 @@
 #ifndef _LTE_VOIPRECEIVER_H_
 #define _LTE_VOIPRECEIVER_H_
 
-#include <list>
 #include <string.h>
+#include <vector>
 
 #include <omnetpp.h>
 
@@ -25,21 +25,32 @@ class SIMULTE_API VoIPReceiver : public omnetpp::cSimpleModule
 {
     inet::UdpSocket socket;
 
-    ~VoIPReceiver();
-
     int emodel_Ie_;
     int emodel_Bpl_;
     int emodel_A_;
     double emodel_Ro_;
 
-    typedef std::list<VoipPacket*> PacketsList;
-    PacketsList mPacketsList_;
-    PacketsList mPlayoutQueue_;
     unsigned int mCurrentTalkspurt_;
     unsigned int mBufferSpace_;
     omnetpp::simtime_t mSamplingDelta_;
     omnetpp::simtime_t mPlayoutDelay_;
 
+    // playout buffer: ring with the playout times of the buffered frames, in insertion order
+    std::vector<omnetpp::simtime_t> mPlayoutRing_;
+    unsigned int mPlayoutHead_;
+
+    // state of the current talkspurt, updated as frames are received
+    unsigned int mTalkspurtFrames_;           // frames of the talkspurt (0 if no frame has been received yet)
+    unsigned int mReceivedFrames_;            // received frames, including duplicates
+    unsigned int mMaxFrameId_;
+    unsigned int mPlayoutLoss_;
+    unsigned int mTailDropLoss_;
+    omnetpp::simtime_t mFirstPlayoutTime_;
+    omnetpp::simtime_t mMaxJitter_;
+    std::vector<bool> mIsArrived_;            // frames inserted into the playout buffer, indexed by frame id
+    std::vector<double> mFrameDelays_;        // frame delays, emitted at the end of the talkspurt
+    std::vector<omnetpp::simtime_t> mLateJitters_;  // jitter of the out-of-time frames, emitted at the end of the talkspurt
+
     bool mInit_;
 
     unsigned int totalRcvdBytes_;
@@ -62,6 +73,7 @@ class SIMULTE_API VoIPReceiver : public omnetpp::cSimpleModule
     void initialize(int stage) override;
     void handleMessage(omnetpp::cMessage *msg) override;
     double eModel(omnetpp::simtime_t delay, double loss);
+    void playoutFrame(const VoipPacket* pPacket);
     void playout(bool finish);
 };
 
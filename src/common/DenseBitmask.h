@@ -0,0 +1,125 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_DENSEBITMASK_H_
+#define _LTE_DENSEBITMASK_H_
+
+#include <vector>
+#include <stdint.h>
+
+//! Set of small unsigned integer keys (e.g. node ids), stored as a growable bitmask.
+/*!
+ Insertion, removal and lookup are O(1). Set keys are enumerated in increasing
+ order, at a cost proportional to the number of words spanned by the mask, so
+ that the enumeration order matches the one of an ordered container.
+ */
+class DenseBitmask
+{
+    //! Mask words, 64 keys each.
+    std::vector<uint64_t> words_;
+
+    //! Number of set keys.
+    unsigned int count_;
+
+  public:
+    //! Create an empty mask.
+    DenseBitmask()
+    {
+        count_ = 0;
+    }
+
+    //! Return true if no key is set.
+    bool empty() const
+    {
+        return (count_ == 0);
+    }
+
+    //! Return the number of set keys.
+    unsigned int count() const
+    {
+        return count_;
+    }
+
+    //! Return true if the given key is set.
+    bool test(unsigned int i) const
+    {
+        unsigned int w = i >> 6;
+        if (w >= words_.size())
+            return false;
+        return (words_[w] >> (i & 63)) & 1;
+    }
+
+    //! Set the given key.
+    void set(unsigned int i)
+    {
+        unsigned int w = i >> 6;
+        if (w >= words_.size())
+            words_.resize(w + 1, 0);
+        uint64_t bit = (uint64_t)1 << (i & 63);
+        if (!(words_[w] & bit))
+        {
+            words_[w] |= bit;
+            ++count_;
+        }
+    }
+
+    //! Clear the given key.
+    void reset(unsigned int i)
+    {
+        unsigned int w = i >> 6;
+        if (w >= words_.size())
+            return;
+        uint64_t bit = (uint64_t)1 << (i & 63);
+        if (words_[w] & bit)
+        {
+            words_[w] &= ~bit;
+            --count_;
+        }
+    }
+
+    //! Set or clear the given key.
+    void assign(unsigned int i, bool value)
+    {
+        if (value)
+            set(i);
+        else
+            reset(i);
+    }
+
+    //! Clear all keys.
+    void clear()
+    {
+        words_.clear();
+        count_ = 0;
+    }
+
+    //! Append the set keys to the given vector, in increasing order.
+    /*!
+     The vector is a snapshot, hence the mask can be modified while
+     the returned keys are processed.
+     */
+    template<typename T>
+    void getKeys(std::vector<T>& keys) const
+    {
+        if (count_ == 0)
+            return;
+        for (unsigned int w = 0; w < words_.size(); ++w)
+        {
+            uint64_t word = words_[w];
+            while (word != 0)
+            {
+                unsigned int b = __builtin_ctzll(word);
+                keys.push_back((T)((w << 6) + b));
+                word &= word - 1;
+            }
+        }
+    }
+};
+
+#endif // _LTE_DENSEBITMASK_H_
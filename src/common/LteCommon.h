@@ -84,6 +84,11 @@ public:
 #define RELAY_MAX_ID 1023
 #define UE_MIN_ID 1025
 #define UE_MAX_ID 65535
+/// Id under which the allocator records the blocks used by the background UEs (see LteBackgroundUeLoad)
+#define BACKGROUND_UE_ID 256
+
+/// First LCID of the connections fed by aggregate traffic sources (see FluidTrafficSource)
+#define FLUID_LCID_BASE 32768
 
 /// Max Number of Codewords
 #define MAX_CODEWORDS 2
@@ -341,6 +346,7 @@ const LtePhyFrameTable phytypes[] = {
     ELEM(HANDOVERPKT),
     ELEM(GRANTPKT),
     ELEM(D2DMODESWITCHPKT),
+    ELEM(CTRLBUNDLEPKT),
     ELEM(UNKNOWN_TYPE)
 };
 
@@ -494,6 +500,14 @@ typedef std::map<std::pair<MacCid, Codeword>, unsigned int> LteMacScheduleList;
  */
 typedef std::map<std::pair<MacNodeId, Codeword>, inet::Packet*> MacPduList;
 
+/**
+ * This is the list of MAC Pdu headers under construction, for
+ * each user on each codeword. SDUs are attached to the header
+ * before it is inserted (once) into the corresponding Pdu.
+ */
+class LteMacPdu;
+typedef std::map<std::pair<MacNodeId, Codeword>, inet::Ptr<LteMacPdu> > MacPduHeaderList;
+
 /*
  * Codeword list : for each node, it keeps track of allocated codewords (number)
  */
@@ -0,0 +1,167 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_RINGBUFFER_H_
+#define _LTE_RINGBUFFER_H_
+
+#include <vector>
+#include <assert.h>
+
+//! Double-ended queue stored in a contiguous, growable circular array.
+/*!
+ All the insertions and extractions at both ends are O(1) (amortized, when
+ the buffer has to grow). The capacity is always a power of two, so that
+ positions can be computed by masking instead of with a modulo.
+ */
+template<typename T>
+class RingBuffer
+{
+    //! Storage. Its size is the current capacity.
+    std::vector<T> buf_;
+
+    //! Position of the first element.
+    unsigned int head_;
+
+    //! Number of elements.
+    unsigned int size_;
+
+    //! Doubles the capacity, moving the elements to the beginning of the new storage.
+    void grow()
+    {
+        std::vector<T> newBuf(buf_.size() * 2);
+        for (unsigned int i = 0; i < size_; ++i)
+            newBuf[i] = buf_[(head_ + i) & (buf_.size() - 1)];
+        buf_.swap(newBuf);
+        head_ = 0;
+    }
+
+  public:
+    //! Create an empty buffer. The initial capacity is rounded up to a power of two.
+    RingBuffer(unsigned int capacity = 8)
+    {
+        unsigned int cap = 1;
+        while (cap < capacity)
+            cap <<= 1;
+        buf_.resize(cap);
+        head_ = 0;
+        size_ = 0;
+    }
+
+    //! Return true if the buffer is empty.
+    bool empty() const
+    {
+        return (size_ == 0);
+    }
+
+    //! Return the number of elements.
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    //! Return the number of elements that can be stored without growing.
+    unsigned int capacity() const
+    {
+        return buf_.size();
+    }
+
+    //! Removes all the elements in the buffer. The capacity is kept.
+    void clear()
+    {
+        for (unsigned int i = 0; i < size_; ++i)
+            buf_[(head_ + i) & (buf_.size() - 1)] = T();
+        head_ = 0;
+        size_ = 0;
+    }
+
+    //! Insert a new element at the back.
+    void pushBack(const T& t)
+    {
+        if (size_ == buf_.size())
+            grow();
+        buf_[(head_ + size_) & (buf_.size() - 1)] = t;
+        ++size_;
+    }
+
+    //! Insert a new element at the front.
+    void pushFront(const T& t)
+    {
+        if (size_ == buf_.size())
+            grow();
+        head_ = (head_ + buf_.size() - 1) & (buf_.size() - 1);
+        buf_[head_] = t;
+        ++size_;
+    }
+
+    //! Extract the element at the front.
+    T popFront()
+    {
+        assert(size_ > 0);
+        T t = buf_[head_];
+        buf_[head_] = T();
+        head_ = (head_ + 1) & (buf_.size() - 1);
+        --size_;
+        return t;
+    }
+
+    //! Extract the element at the back.
+    T popBack()
+    {
+        assert(size_ > 0);
+        unsigned int pos = (head_ + size_ - 1) & (buf_.size() - 1);
+        T t = buf_[pos];
+        buf_[pos] = T();
+        --size_;
+        return t;
+    }
+
+    //! Return the element at the front.
+    T& front()
+    {
+        assert(size_ > 0);
+        return buf_[head_];
+    }
+
+    //! Return the element at the front.
+    const T& front() const
+    {
+        assert(size_ > 0);
+        return buf_[head_];
+    }
+
+    //! Return the element at the back.
+    T& back()
+    {
+        assert(size_ > 0);
+        return buf_[(head_ + size_ - 1) & (buf_.size() - 1)];
+    }
+
+    //! Return the element at the back.
+    const T& back() const
+    {
+        assert(size_ > 0);
+        return buf_[(head_ + size_ - 1) & (buf_.size() - 1)];
+    }
+
+    //! Return the i-th element, counting from the front.
+    T& at(unsigned int i)
+    {
+        assert(i < size_);
+        return buf_[(head_ + i) & (buf_.size() - 1)];
+    }
+
+    //! Return the i-th element, counting from the front.
+    const T& at(unsigned int i) const
+    {
+        assert(i < size_);
+        return buf_[(head_ + i) & (buf_.size() - 1)];
+    }
+};
+
+#endif // _LTE_RINGBUFFER_H_
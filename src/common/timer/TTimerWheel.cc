@@ -0,0 +1,296 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "common/timer/TTimerWheel.h"
+
+using namespace omnetpp;
+
+TTimerWheel::TTimerWheel(cSimpleModule* module, simtime_t resolution)
+{
+    if (resolution <= 0)
+        throw cRuntimeError("TTimerWheel::TTimerWheel(): invalid resolution %s", resolution.str().c_str());
+
+    module_ = module;
+    msg_ = nullptr;
+    resolution_ = resolution;
+    cursor_ = 0;
+    nextSeq_ = 0;
+    freeList_ = -1;
+    heads_.resize(NUM_LISTS, -1);
+    tails_.resize(NUM_LISTS, -1);
+    for (unsigned int i = 0; i < L0_SLOTS / 64; i++)
+        l0Busy_[i] = 0;
+    l1Busy_ = 0;
+}
+
+TTimerWheel::~TTimerWheel()
+{
+    if (msg_ != nullptr)
+        module_->cancelAndDelete(msg_);
+}
+
+unsigned int TTimerWheel::count(unsigned int timerId) const
+{
+    std::map<unsigned int, unsigned int>::const_iterator it = counts_.find(timerId);
+    return (it != counts_.end()) ? it->second : 0;
+}
+
+simtime_t TTimerWheel::getExpireTime(unsigned int timerId, unsigned int event) const
+{
+    std::unordered_map<uint64_t, int>::const_iterator it = index_.find(key(timerId, event));
+    if (it == index_.end())
+        throw cRuntimeError("TTimerWheel::getExpireTime(): element %d of timer %d not found", event, timerId);
+    return entries_[it->second].expire;
+}
+
+int TTimerWheel::listFor(int64_t tick) const
+{
+    int64_t block = tick >> L0_BITS;
+    int64_t cursorBlock = cursor_ >> L0_BITS;
+
+    if (block == cursorBlock)
+        return tick & (L0_SLOTS - 1);
+    if (block - cursorBlock < L1_SLOTS)
+        return L0_SLOTS + (block & (L1_SLOTS - 1));
+    return OVERFLOW_LIST;
+}
+
+void TTimerWheel::link(int idx, int list)
+{
+    Entry& e = entries_[idx];
+    e.list = list;
+    e.next = -1;
+    e.prev = tails_[list];
+    if (tails_[list] != -1)
+        entries_[tails_[list]].next = idx;
+    else
+        heads_[list] = idx;
+    tails_[list] = idx;
+
+    if (list < L0_SLOTS)
+        l0Busy_[list >> 6] |= (uint64_t)1 << (list & 63);
+    else if (list < OVERFLOW_LIST)
+        l1Busy_ |= (uint64_t)1 << (list - L0_SLOTS);
+}
+
+void TTimerWheel::unlink(int idx)
+{
+    Entry& e = entries_[idx];
+    int list = e.list;
+    if (e.prev != -1)
+        entries_[e.prev].next = e.next;
+    else
+        heads_[list] = e.next;
+    if (e.next != -1)
+        entries_[e.next].prev = e.prev;
+    else
+        tails_[list] = e.prev;
+
+    if (heads_[list] == -1)
+    {
+        if (list < L0_SLOTS)
+            l0Busy_[list >> 6] &= ~((uint64_t)1 << (list & 63));
+        else if (list < OVERFLOW_LIST)
+            l1Busy_ &= ~((uint64_t)1 << (list - L0_SLOTS));
+    }
+    e.list = -1;
+}
+
+void TTimerWheel::redistribute(int list)
+{
+    int idx = heads_[list];
+    if (idx == -1)
+        return;
+
+    // detach the whole list, then re-insert its entries in their original order
+    heads_[list] = -1;
+    tails_[list] = -1;
+    if (list < L0_SLOTS)
+        l0Busy_[list >> 6] &= ~((uint64_t)1 << (list & 63));
+    else if (list < OVERFLOW_LIST)
+        l1Busy_ &= ~((uint64_t)1 << (list - L0_SLOTS));
+
+    while (idx != -1)
+    {
+        int next = entries_[idx].next;
+        link(idx, listFor(tickOf(entries_[idx].expire)));
+        idx = next;
+    }
+}
+
+void TTimerWheel::advance()
+{
+    int64_t now = tickOf(NOW);
+    if (now <= cursor_)
+        return;
+
+    int64_t oldBlock = cursor_ >> L0_BITS;
+    cursor_ = now;
+    int64_t newBlock = cursor_ >> L0_BITS;
+    if (newBlock == oldBlock)
+        return;
+
+    // no event can be left in the first level, since all of them belong to an elapsed block.
+    // Entries of the second level whose block has been reached go to the first level
+    if (newBlock - oldBlock >= L1_SLOTS)
+    {
+        for (int i = 0; i < L1_SLOTS; i++)
+            redistribute(L0_SLOTS + i);
+    }
+    else
+        redistribute(L0_SLOTS + (newBlock & (L1_SLOTS - 1)));
+
+    // overflow entries may now fall within the second level
+    redistribute(OVERFLOW_LIST);
+}
+
+int TTimerWheel::earliestIn(int list) const
+{
+    int best = -1;
+    for (int idx = heads_[list]; idx != -1; idx = entries_[idx].next)
+    {
+        const Entry& e = entries_[idx];
+        if (best == -1 || e.expire < entries_[best].expire
+            || (e.expire == entries_[best].expire && e.seq < entries_[best].seq))
+        {
+            best = idx;
+        }
+    }
+    return best;
+}
+
+simtime_t TTimerWheel::nextWakeup() const
+{
+    // first level: all the slots hold ticks not before the current one
+    for (unsigned int w = 0; w < L0_SLOTS / 64; w++)
+    {
+        if (l0Busy_[w] != 0)
+            return entries_[earliestIn(w * 64 + __builtin_ctzll(l0Busy_[w]))].expire;
+    }
+
+    // second level: wake up at the beginning of the first non-empty block, to cascade it
+    if (l1Busy_ != 0)
+    {
+        int64_t cursorBlock = cursor_ >> L0_BITS;
+        int shift = (cursorBlock + 1) & (L1_SLOTS - 1);
+        uint64_t rotated = (shift == 0) ? l1Busy_ : ((l1Busy_ >> shift) | (l1Busy_ << (L1_SLOTS - shift)));
+        int64_t block = cursorBlock + 1 + __builtin_ctzll(rotated);
+
+        simtime_t t;
+        t.setRaw((block << L0_BITS) * resolution_.raw());
+        return t;
+    }
+
+    // overflow: advance() will cascade all the levels at the earliest expire time
+    return entries_[earliestIn(OVERFLOW_LIST)].expire;
+}
+
+void TTimerWheel::scheduleMessage(simtime_t t)
+{
+    if (msg_ == nullptr)
+        msg_ = new cMessage("timerWheel");
+
+    if (msg_->isScheduled())
+    {
+        if (msg_->getArrivalTime() == t)
+            return;
+        module_->cancelEvent(msg_);
+    }
+    module_->scheduleAt(t, msg_);
+}
+
+void TTimerWheel::reschedule()
+{
+    if (index_.empty())
+    {
+        if (msg_ != nullptr && msg_->isScheduled())
+            module_->cancelEvent(msg_);
+        return;
+    }
+    scheduleMessage(nextWakeup());
+}
+
+void TTimerWheel::add(simtime_t t, unsigned int timerId, unsigned int event)
+{
+    uint64_t k = key(timerId, event);
+    if (index_.find(k) != index_.end())
+        throw cRuntimeError("TTimerWheel::add(): element %d of timer %d already exists", event, timerId);
+
+    advance();
+
+    int idx;
+    if (freeList_ != -1)
+    {
+        idx = freeList_;
+        freeList_ = entries_[idx].next;
+    }
+    else
+    {
+        idx = entries_.size();
+        entries_.push_back(Entry());
+    }
+
+    Entry& e = entries_[idx];
+    e.expire = NOW + t;
+    e.seq = nextSeq_++;
+    e.key = k;
+    link(idx, listFor(tickOf(e.expire)));
+
+    index_[k] = idx;
+    counts_[timerId]++;
+
+    // anticipate the timer message if this event expires earlier
+    if (msg_ == nullptr || !msg_->isScheduled() || e.expire < msg_->getArrivalTime())
+        scheduleMessage(e.expire);
+}
+
+void TTimerWheel::remove(unsigned int timerId, unsigned int event)
+{
+    std::unordered_map<uint64_t, int>::iterator it = index_.find(key(timerId, event));
+    if (it == index_.end())
+        throw cRuntimeError("TTimerWheel::remove(): element %d of timer %d not found", event, timerId);
+
+    advance();
+
+    int idx = it->second;
+    simtime_t expire = entries_[idx].expire;
+    unlink(idx);
+    entries_[idx].next = freeList_;
+    freeList_ = idx;
+    index_.erase(it);
+    counts_[timerId]--;
+
+    // the timer message is postponed only if it was scheduled for this event
+    if (msg_ != nullptr && msg_->isScheduled() && msg_->getArrivalTime() == expire)
+        reschedule();
+}
+
+bool TTimerWheel::popExpired(unsigned int& timerId, unsigned int& event)
+{
+    advance();
+
+    // expired events can only be in the slot of the current tick
+    int idx = earliestIn(cursor_ & (L0_SLOTS - 1));
+    if (idx == -1 || entries_[idx].expire > NOW)
+    {
+        reschedule();
+        return false;
+    }
+
+    uint64_t k = entries_[idx].key;
+    timerId = (unsigned int)(k >> 32);
+    event = (unsigned int)(k & 0xffffffff);
+
+    unlink(idx);
+    entries_[idx].next = freeList_;
+    freeList_ = idx;
+    index_.erase(k);
+    counts_[timerId]--;
+    return true;
+}
@@ -0,0 +1,337 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_TTIMERWHEEL_H_
+#define _LTE_TTIMERWHEEL_H_
+
+#include <unordered_map>
+#include "common/LteCommon.h"
+
+/*!
+ * Hierarchical timing wheel serving all the timers of one module.
+ *
+ * Events are identified by a (timerId, event) pair, and are kept into
+ * two levels of slots: the first level has one slot per tick (of the
+ * given resolution) of the current block of 256 ticks, the second level
+ * one slot per block, for the following 63 blocks. Farther events are kept
+ * in an overflow list. Adding and removing events is O(1).
+ *
+ * A single self-message is owned by the wheel and rescheduled at the
+ * earliest expire time (or at the beginning of the block containing it),
+ * hence no message is allocated per event. The exact expire time of each
+ * event is kept, and events expiring at the same time are dispatched in
+ * insertion order.
+ *
+ * The owning module must check incoming messages with isTimerMessage(),
+ * and extract the expired events with popExpired(). The timer message
+ * must not be deleted by the module.
+ */
+class SIMULTE_API TTimerWheel : public omnetpp::cObject
+{
+  public:
+    /*! Build an empty wheel.
+     *
+     * @param module the owning module, which will receive the timer message
+     * @param resolution the duration of a tick
+     */
+    TTimerWheel(omnetpp::cSimpleModule* module, omnetpp::simtime_t resolution = TTI);
+
+    //! Cancel and delete the timer message.
+    virtual ~TTimerWheel();
+
+    /*! Add an event, which must not be already scheduled.
+     *
+     * @param t interval before the event expires
+     * @param timerId identifier of the timer the event belongs to
+     * @param event the event id
+     */
+    void add(omnetpp::simtime_t t, unsigned int timerId, unsigned int event);
+
+    /*! Remove a scheduled event.
+     *
+     * @param timerId identifier of the timer the event belongs to
+     * @param event the event id
+     */
+    void remove(unsigned int timerId, unsigned int event);
+
+    /*! Return true if the event is scheduled.
+     *
+     * @param timerId identifier of the timer the event belongs to
+     * @param event the event id
+     */
+    bool busy(unsigned int timerId, unsigned int event) const
+    {
+        return (index_.find(key(timerId, event)) != index_.end());
+    }
+
+    /*! Return the number of scheduled events of the given timer.
+     *
+     * @param timerId identifier of the timer
+     */
+    unsigned int count(unsigned int timerId) const;
+
+    /*! Return the expire time of a scheduled event.
+     *
+     * @param timerId identifier of the timer the event belongs to
+     * @param event the event id
+     */
+    omnetpp::simtime_t getExpireTime(unsigned int timerId, unsigned int event) const;
+
+    /*! Return true if the given message is the timer message of this wheel.
+     *
+     * @param msg the message received by the owning module
+     */
+    bool isTimerMessage(const omnetpp::cMessage* msg) const
+    {
+        return (msg != nullptr && msg == msg_);
+    }
+
+    /*! Extract the earliest event expired at the current time, if any.
+     * To be called repeatedly on reception of the timer message, until it
+     * returns false. The timer message is then rescheduled if needed.
+     *
+     * @param timerId filled with the identifier of the timer the event belongs to
+     * @param event filled with the event id
+     * @return true if an event has been extracted
+     */
+    bool popExpired(unsigned int& timerId, unsigned int& event);
+
+  protected:
+    //! Number of ticks in a block (first level slots)
+    static const int64_t L0_SLOTS = 256;
+    static const int L0_BITS = 8;
+    //! Number of blocks covered by the second level slots
+    static const int64_t L1_SLOTS = 64;
+    //! Lists index: first level slots, then second level slots, then overflow
+    static const int OVERFLOW_LIST = L0_SLOTS + L1_SLOTS;
+    static const int NUM_LISTS = OVERFLOW_LIST + 1;
+
+    struct Entry
+    {
+        omnetpp::simtime_t expire;
+        uint64_t seq;
+        uint64_t key;
+        int list;
+        int prev;
+        int next;
+    };
+
+    static uint64_t key(unsigned int timerId, unsigned int event)
+    {
+        return ((uint64_t)timerId << 32) | event;
+    }
+
+    int64_t tickOf(omnetpp::simtime_t t) const
+    {
+        return t.raw() / resolution_.raw();
+    }
+
+    //! Return the list an event expiring at the given tick belongs to
+    int listFor(int64_t tick) const;
+
+    //! Append an entry to a list
+    void link(int idx, int list);
+
+    //! Detach an entry from its list
+    void unlink(int idx);
+
+    //! Move the current tick to the current time, cascading the entries of the reached blocks
+    void advance();
+
+    //! Re-insert the entries of the given list according to the current tick
+    void redistribute(int list);
+
+    //! Return the time the timer message must be scheduled at (the wheel must not be empty)
+    omnetpp::simtime_t nextWakeup() const;
+
+    //! Return the entry with the earliest (expire, seq) in the given list, -1 if empty
+    int earliestIn(int list) const;
+
+    //! Schedule the timer message at the given time, unless already scheduled then
+    void scheduleMessage(omnetpp::simtime_t t);
+
+    //! Reschedule the timer message according to the wheel content
+    void reschedule();
+
+    //! Owning module
+    omnetpp::cSimpleModule* module_;
+
+    //! Timer message, created on first use
+    omnetpp::cMessage* msg_;
+
+    //! Duration of a tick
+    omnetpp::simtime_t resolution_;
+
+    //! Current tick
+    int64_t cursor_;
+
+    //! Insertion counter, used to dispatch events expiring at the same time in FIFO order
+    uint64_t nextSeq_;
+
+    //! Entries storage, and list of free entries (linked by next)
+    std::vector<Entry> entries_;
+    int freeList_;
+
+    //! First entry of each list
+    std::vector<int> heads_;
+    //! Last entry of each list
+    std::vector<int> tails_;
+
+    //! Non-empty first level slots (bit per slot)
+    uint64_t l0Busy_[L0_SLOTS / 64];
+    //! Non-empty second level slots (bit per slot)
+    uint64_t l1Busy_;
+
+    //! Event key to entry index
+    std::unordered_map<uint64_t, int> index_;
+
+    //! Number of scheduled events per timer
+    std::map<unsigned int, unsigned int> counts_;
+};
+
+/*!
+ * Timer with the same interface as TTimer, backed by a TTimerWheel.
+ * There is no handle() call-back: popExpired() already removes the expired event.
+ */
+class SIMULTE_API TWheelTimer
+{
+  public:
+    /*! Build an idle timer.
+     *
+     * @param wheel the timing wheel of the owning module
+     */
+    TWheelTimer(TTimerWheel* wheel)
+    {
+        wheel_ = wheel;
+        start_ = 0;
+        timerId_ = 0;
+    }
+
+    /*! Start the timer, unless it is already busy.
+     *
+     * @param t interval before timer is triggered
+     */
+    void start(omnetpp::simtime_t t)
+    {
+        if (busy())
+            return;
+        wheel_->add(t, timerId_, 0);
+        start_ = NOW;
+    }
+
+    //! Stop the timer, if busy.
+    void stop()
+    {
+        if (busy())
+            wheel_->remove(timerId_, 0);
+    }
+
+    unsigned int getTimerId() const
+    {
+        return timerId_;
+    }
+
+    void setTimerId(unsigned int timerId)
+    {
+        timerId_ = timerId;
+    }
+
+    bool busy() const
+    {
+        return wheel_->busy(timerId_, 0);
+    }
+
+    bool idle() const
+    {
+        return !busy();
+    }
+
+    omnetpp::simtime_t elapsed() const
+    {
+        return NOW - start_;
+    }
+
+    omnetpp::simtime_t remaining() const
+    {
+        return busy() ? wheel_->getExpireTime(timerId_, 0) - NOW : omnetpp::SIMTIME_ZERO;
+    }
+
+  protected:
+    TTimerWheel* wheel_;
+    unsigned int timerId_;
+    omnetpp::simtime_t start_;
+};
+
+/*!
+ * Multi-timer with the same interface as TMultiTimer, backed by a TTimerWheel.
+ * There is no handle() call-back: popExpired() already removes the expired event.
+ */
+class SIMULTE_API TWheelMultiTimer
+{
+  public:
+    /*! Build an idle multi-timer.
+     *
+     * @param wheel the timing wheel of the owning module
+     */
+    TWheelMultiTimer(TTimerWheel* wheel)
+    {
+        wheel_ = wheel;
+        timerId_ = 0;
+    }
+
+    /*! Add an event. Event ids are assumed to be unique
+     *
+     * @param t the interval before the event expires
+     * @param event the event id
+     */
+    void add(omnetpp::simtime_t t, unsigned int event)
+    {
+        wheel_->add(t, timerId_, event);
+    }
+
+    /*! Remove an event
+     *
+     * @param event event to be removed
+     */
+    void remove(const unsigned int event)
+    {
+        wheel_->remove(timerId_, event);
+    }
+
+    unsigned int getTimerId() const
+    {
+        return timerId_;
+    }
+
+    void setTimerId(unsigned int timerId)
+    {
+        timerId_ = timerId;
+    }
+
+    bool busy() const
+    {
+        return (wheel_->count(timerId_) > 0);
+    }
+
+    bool busy(const unsigned int event) const
+    {
+        return wheel_->busy(timerId_, event);
+    }
+
+    bool idle() const
+    {
+        return !busy();
+    }
+
+  protected:
+    TTimerWheel* wheel_;
+    unsigned int timerId_;
+};
+
+#endif
@@ -13,6 +13,11 @@
 
 #include "../lteCellInfo/LteCellInfo.h"
 #include "corenetwork/nodes/InternetMux.h"
+#include "stack/phy/layer/LtePhyUe.h"
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 using namespace inet;
@@ -24,24 +29,25 @@ void LteBinder::unregisterNode(MacNodeId id)
     EV << NOW << " LteBinder::unregisterNode - unregistering node " << id << endl;
 
 
-    std::map<Ipv4Address, MacNodeId>::iterator it;
+    std::unordered_map<uint32_t, MacNodeId>::iterator it;
     for(it = macNodeIdToIPAddress_.begin(); it != macNodeIdToIPAddress_.end(); )
     {
         if(it->second == id)
         {
-            macNodeIdToIPAddress_.erase(it++);
+            it = macNodeIdToIPAddress_.erase(it);
         }
         else
         {
             it++;
         }
     }
+    addressMapVersion_++;
 
-    // iterate all nodeIds and find HarqRx buffers dependent on 'id'
+    // iterate all nodeIds and find HarqRx/HarqTx buffers dependent on 'id'
     std::map<int, OmnetId>::iterator idIter;
     for (idIter = nodeIds_.begin(); idIter != nodeIds_.end(); idIter++){
         LteMacBase* mac = getMacFromMacNodeId(idIter->first);
-        mac->unregisterHarqBufferRx(id);
+        mac->unregisterHarqBuffers(id);
     }
 
     // remove 'id' from ModuleName cache
@@ -58,6 +64,17 @@ void LteBinder::unregisterNode(MacNodeId id)
     if(nodeIds_.erase(id) != 1){
         EV_ERROR << "Cannot unregister node - node id \"" << id << "\" - not found";
     }
+    // remove 'id' from the multicast groups it was enrolled in
+    std::map<MacNodeId, MulticastGroupIdSet>::iterator mit = multicastGroupMap_.find(id);
+    if (mit != multicastGroupMap_.end())
+    {
+        MulticastGroupIdSet::iterator git = mit->second.begin();
+        for ( ; git != mit->second.end(); ++git)
+            multicastGroupMembers_[*git].erase(id);
+        multicastGroupMap_.erase(mit);
+    }
+    multicastTransmitterSet_.erase(id);
+
     // remove 'id' from ulTransmissionMap_
     for(auto &bands : ulTransmissionMap_){ //all RB's for current and last TTI
         for(auto &ues : bands){ // all Ue's in each block
@@ -136,9 +153,68 @@ void LteBinder::initialize(int stage)
     if (stage == inet::INITSTAGE_LOCAL)
     {
         numBands_ = par("numBands");
+        centralizedHandoverMeasurement_ = par("centralizedHandoverMeasurement");
+
+        if (par("recordMemoryUsage").boolValue())
+        {
+            // scheduled at time 0, it is handled after the initialization of all the modules
+            memorySampleTimer_ = new cMessage("memorySample");
+            scheduleAt(simTime(), memorySampleTimer_);
+        }
+    }
+}
+
+/*
+ * Peak resident set size of the process, in bytes (0 if not available)
+ */
+static long getPeakResidentMemory()
+{
+#if defined(_WIN32)
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return usage.ru_maxrss;
+#else
+    return usage.ru_maxrss * 1024L;   // in kB on Linux
+#endif
+#endif
+}
+
+void LteBinder::handleMessage(cMessage *msg)
+{
+    if (msg->isSelfMessage() && msg->isName("handoverMeasurement"))
+    {
+        HandoverMeasurementGroup* group = static_cast<HandoverMeasurementGroup*>(msg->getContextPointer());
+        measureHandoverCandidates(*group);
+        scheduleAt(NOW + group->interval, msg);
+    }
+    else if (msg == memorySampleTimer_)
+    {
+        setupMemory_ = getPeakResidentMemory();
+        setupNumUes_ = ueList_.size();
+        EV << "LteBinder::handleMessage - resident memory after setup: " << setupMemory_ << " bytes, " << setupNumUes_ << " UEs" << endl;
+    }
+    else
+    {
+        delete msg;
     }
 }
 
+void LteBinder::finish()
+{
+    if (setupMemory_ == 0)
+        return;
+
+    recordScalar("setupMemory", setupMemory_);
+    recordScalar("numUes", setupNumUes_);
+    if (setupNumUes_ > 0)
+        recordScalar("setupMemoryPerUe", (double)setupMemory_ / setupNumUes_);
+    recordScalar("peakMemory", getPeakResidentMemory());
+}
+
 void LteBinder::unregisterNextHop(MacNodeId masterId, MacNodeId slaveId)
 {
     Enter_Method_Silent("unregisterNextHop");
@@ -403,6 +479,7 @@ void LteBinder::registerMulticastGroup(MacNodeId nodeId, int32_t groupId)
     {
         multicastGroupMap_[nodeId].insert(groupId);
     }
+    multicastGroupMembers_[groupId].insert(nodeId);
 }
 
 bool LteBinder::isInMulticastGroup(MacNodeId nodeId, int32_t groupId)
@@ -415,6 +492,14 @@ bool LteBinder::isInMulticastGroup(MacNodeId nodeId, int32_t groupId)
     return true;
 }
 
+const LteBinder::MulticastGroupMemberSet* LteBinder::getMulticastGroupMembers(int32_t groupId)
+{
+    std::map<int32_t, MulticastGroupMemberSet>::iterator it = multicastGroupMembers_.find(groupId);
+    if (it == multicastGroupMembers_.end())
+        return nullptr;
+    return &(it->second);
+}
+
 void LteBinder::addD2DMulticastTransmitter(MacNodeId nodeId)
 {
     multicastTransmitterSet_.insert(nodeId);
@@ -455,3 +540,66 @@ void LteBinder::removeUeHandoverTriggered(MacNodeId nodeId)
 {
     ueHandoverTriggered_.erase(nodeId);
 }
+
+void LteBinder::registerHandoverMeasurementSource(MacNodeId enbId, LtePhyBase* phy, double interval)
+{
+    Enter_Method_Silent("registerHandoverMeasurementSource");
+
+    HandoverMeasurementGroup& group = handoverMeasurementGroups_[interval];
+    if (group.timer == nullptr)
+    {
+        // the first measurement takes place when the first broadcast would be sent
+        group.interval = interval;
+        group.timer = new cMessage("handoverMeasurement");
+        group.timer->setContextPointer(&group);
+        // measure when the broadcasts would have been received, i.e. after the mobility updates at the same time
+        group.timer->setSchedulingPriority(LtePhyBase::getAirFramePriority());
+        scheduleAt(NOW, group.timer);
+    }
+    group.sources.push_back(std::make_pair(phy->getId(), enbId));
+
+    EV << "LteBinder::registerHandoverMeasurementSource - eNB " << enbId << " measured every " << interval << "s" << endl;
+}
+
+void LteBinder::measureHandoverCandidates(HandoverMeasurementGroup& group)
+{
+    // UEs in range of any eNB, in the order they would have received the first broadcast,
+    // each with its candidates in the order the broadcasts would have been received
+    std::vector<std::pair<LtePhyUe*, std::vector<HandoverCandidate> > > measurements;
+    std::unordered_map<LtePhyUe*, unsigned int> measurementIndex;
+    std::vector<cModule*> radios;
+
+    for (unsigned int i = 0; i < group.sources.size(); i++)
+    {
+        LtePhyBase* enbPhy = dynamic_cast<LtePhyBase*>(getSimulation()->getModule(group.sources[i].first));
+        if (enbPhy == nullptr)
+            continue;   // the eNB has left the simulation
+
+        // same parameters as the broadcast frame
+        HandoverCandidate candidate;
+        candidate.id = group.sources[i].second;
+        candidate.txPower = enbPhy->getTxPwr();
+        candidate.coord = enbPhy->getCoord();
+
+        // the radios in range are the ones the broadcast would have been delivered to
+        radios.clear();
+        enbPhy->getRadiosInRange(radios);
+        for (unsigned int j = 0; j < radios.size(); j++)
+        {
+            LtePhyUe* uePhy = dynamic_cast<LtePhyUe*>(radios[j]);
+            if (uePhy == nullptr)
+                continue;   // eNBs and relays ignore handover broadcasts
+
+            std::pair<std::unordered_map<LtePhyUe*, unsigned int>::iterator, bool> ins =
+                measurementIndex.insert(std::make_pair(uePhy, (unsigned int)measurements.size()));
+            if (ins.second)
+                measurements.push_back(std::make_pair(uePhy, std::vector<HandoverCandidate>()));
+            measurements[ins.first->second].second.push_back(candidate);
+        }
+    }
+
+    EV << "LteBinder::measureHandoverCandidates - " << measurements.size() << " UEs in range of " << group.sources.size() << " eNBs" << endl;
+
+    for (unsigned int i = 0; i < measurements.size(); i++)
+        measurements[i].first->handleHandoverCandidates(measurements[i].second);
+}
@@ -12,6 +12,7 @@
 
 #include <omnetpp.h>
 #include <string>
+#include <unordered_map>
 
 #include <inet/networklayer/contract/ipv4/Ipv4Address.h>
 #include <inet/networklayer/common/L3Address.h>
@@ -40,11 +41,15 @@
 
 class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
 {
+  public:
+    typedef std::set<MacNodeId> MulticastGroupMemberSet;
+
   private:
     typedef std::map<MacNodeId, std::map<MacNodeId, bool> > DeployedUesMap;
 
     unsigned int numBands_;  // number of logical bands
-    std::map<inet::Ipv4Address, MacNodeId> macNodeIdToIPAddress_;
+    std::unordered_map<uint32_t, MacNodeId> macNodeIdToIPAddress_; // indexed by the integer value of the address
+    unsigned int addressMapVersion_; // incremented whenever the above table is modified
     std::map<MacNodeId, char*> macNodeIdToModuleName_;
     std::map<MacNodeId, LteMacBase*> macNodeIdToModule_;
     std::vector<MacNodeId> nextHop_; // MacNodeIdMaster --> MacNodeIdSlave
@@ -91,6 +96,8 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
     // register here the IDs of the multicast group where UEs participate
     typedef std::set<uint32_t> MulticastGroupIdSet;
     std::map<MacNodeId, MulticastGroupIdSet> multicastGroupMap_;
+    // reverse index, storing the members of each multicast group
+    std::map<int32_t, MulticastGroupMemberSet> multicastGroupMembers_;
     std::set<MacNodeId> multicastTransmitterSet_;
 
     /*
@@ -98,14 +105,44 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
      */
     // store the id of the UEs that are performing handover
     std::set<MacNodeId> ueHandoverTriggered_;
+
+    // if true, handover broadcasts are not sent, and the binder measures them for all the UEs
+    bool centralizedHandoverMeasurement_;
+    // eNBs whose broadcasts are measured at the same interval
+    struct HandoverMeasurementGroup
+    {
+        omnetpp::cMessage* timer;
+        double interval;
+        // module id of the PHY and MacNodeId of each eNB, in registration order
+        std::vector<std::pair<int, MacNodeId> > sources;
+
+        HandoverMeasurementGroup() : timer(nullptr), interval(0) {}
+    };
+    // indexed by broadcast interval
+    std::map<double, HandoverMeasurementGroup> handoverMeasurementGroups_;
+
+    /*
+     * Memory usage report
+     */
+    // sampled when the simulation starts, after network setup
+    omnetpp::cMessage* memorySampleTimer_;
+    long setupMemory_;
+    unsigned int setupNumUes_;
+
   protected:
     virtual void initialize(int stages) override;
 
     virtual int numInitStages() const override { return inet::INITSTAGE_LAST; }
 
-    virtual void handleMessage(omnetpp::cMessage *msg) override
-    {
-    }
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+
+    virtual void finish() override;
+
+    /*
+     * Measure the broadcasts of the eNBs in the group, and deliver to each UE
+     * in range of any of them the list of its candidate serving cells
+     */
+    void measureHandoverCandidates(HandoverMeasurementGroup& group);
 
   public:
     LteBinder()
@@ -113,6 +150,11 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
         macNodeIdCounter_[0] = ENB_MIN_ID;
         macNodeIdCounter_[1] = RELAY_MIN_ID;
         macNodeIdCounter_[2] = UE_MIN_ID;
+        addressMapVersion_ = 0;
+        centralizedHandoverMeasurement_ = false;
+        memorySampleTimer_ = nullptr;
+        setupMemory_ = 0;
+        setupNumUes_ = 0;
 
         ulTransmissionMap_.resize(2); // store transmission map of previous and current TTI
     }
@@ -124,6 +166,11 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
 
     virtual ~LteBinder()
     {
+        std::map<double, HandoverMeasurementGroup>::iterator it = handoverMeasurementGroups_.begin();
+        for (; it != handoverMeasurementGroups_.end(); ++it)
+            cancelAndDelete(it->second.timer);
+        cancelAndDelete(memorySampleTimer_);
+
         while(enbList_.size() > 0){
             delete enbList_.back();
             enbList_.pop_back();
@@ -223,9 +270,20 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
      */
     MacNodeId getMacNodeId(inet::Ipv4Address address)
     {
-        if (macNodeIdToIPAddress_.find(address) == macNodeIdToIPAddress_.end())
+        std::unordered_map<uint32_t, MacNodeId>::const_iterator it = macNodeIdToIPAddress_.find(address.getInt());
+        if (it == macNodeIdToIPAddress_.end())
             return 0;
-        return macNodeIdToIPAddress_[address];
+        return it->second;
+    }
+
+    /**
+     * Returns a counter that changes whenever an IP address is associated to, or
+     * removed from, a MacNodeId. Modules caching the results of getMacNodeId()
+     * can check it to detect stale entries
+     */
+    unsigned int getAddressMapVersion() const
+    {
+        return addressMapVersion_;
     }
 
     /**
@@ -246,7 +304,8 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
      */
     void setMacNodeId(inet::Ipv4Address address, MacNodeId nodeId)
     {
-        macNodeIdToIPAddress_[address] = nodeId;
+        macNodeIdToIPAddress_[address.getInt()] = nodeId;
+        addressMapVersion_++;
     }
     /**
      * Associates the given IP address with the given X2NodeId.
@@ -349,6 +408,8 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
     void registerMulticastGroup(MacNodeId nodeId, int32_t groupId);
     // check if the node is enrolled in the group
     bool isInMulticastGroup(MacNodeId nodeId, int32_t groupId);
+    // get the nodes enrolled in the group (nullptr if the group has no members)
+    const MulticastGroupMemberSet* getMulticastGroupMembers(int32_t groupId);
     // add one multicast transmitter
     void addD2DMulticastTransmitter(MacNodeId nodeId);
     // get multicast transmitters
@@ -360,6 +421,13 @@ class SIMULTE_API LteBinder : public omnetpp::cSimpleModule
     bool hasUeHandoverTriggered(MacNodeId nodeId);
     void removeUeHandoverTriggered(MacNodeId nodeId);
     void updateUeInfoCellId(MacNodeId nodeId, MacCellId cellId);
+    // true if the eNBs must register with the binder instead of sending handover broadcasts
+    bool isHandoverMeasurementCentralized() const
+    {
+        return centralizedHandoverMeasurement_;
+    }
+    // register an eNB whose handover broadcast is measured every interval seconds
+    void registerHandoverMeasurementSource(MacNodeId enbId, LtePhyBase* phy, double interval);
 };
 
 #endif
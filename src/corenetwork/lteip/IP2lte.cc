@@ -191,6 +191,25 @@ void IP2lte::fromIpUe(Packet * datagram)
     }
 }
 
+IP2lte::FlowInfo& IP2lte::getFlowInfo(const Ipv4Address& srcAddr, const Ipv4Address& destAddr)
+{
+    uint64_t key = ((uint64_t)srcAddr.getInt() << 32) | destAddr.getInt();
+    std::pair<std::unordered_map<uint64_t, FlowInfo>::iterator, bool> ret = flows_.emplace(key, FlowInfo());
+    FlowInfo& flow = ret.first->second;
+    if (ret.second)
+    {
+        flow.seqNum = 0;
+        flow.destId = binder_->getMacNodeId(destAddr);
+        flow.addressMapVersion = binder_->getAddressMapVersion();
+    }
+    else if (flow.addressMapVersion != binder_->getAddressMapVersion())
+    {
+        flow.destId = binder_->getMacNodeId(destAddr);
+        flow.addressMapVersion = binder_->getAddressMapVersion();
+    }
+    return flow;
+}
+
 void IP2lte::toStackUe(Packet * pkt)
 {
     auto iphdr = pkt->peekAtFront<Ipv4Header>();
@@ -201,12 +220,7 @@ void IP2lte::toStackUe(Packet * pkt)
     int headerSize = iphdr->getHeaderLength().get();
 
     // if needed, create a new structure for the flow
-    AddressPair pair(srcAddr, destAddr);
-    if (seqNums_.find(pair) == seqNums_.end())
-    {
-        std::pair<AddressPair, unsigned int> p(pair, 0);
-        seqNums_.insert(p);
-    }
+    FlowInfo& flow = getFlowInfo(srcAddr, destAddr);
 
     // inspect packet depending on the transport protocol type
     // TODO: needs refactoring (redundant code, see toStackBs())
@@ -224,7 +238,7 @@ void IP2lte::toStackUe(Packet * pkt)
     pkt->addTagIfAbsent<FlowControlInfo>()->setSrcAddr(srcAddr.getInt());
     pkt->addTagIfAbsent<FlowControlInfo>()->setDstAddr(destAddr.getInt());
     pkt->addTagIfAbsent<FlowControlInfo>()->setTypeOfService(tos);
-    pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(seqNums_[pair]++);
+    pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(flow.seqNum++);
     pkt->addTagIfAbsent<FlowControlInfo>()->setHeaderSize(headerSize);
     
     printControlInfo(pkt);
@@ -270,11 +284,12 @@ void IP2lte::fromIpEnb(Packet * pkt)
     const Ipv4Address& destAddr = datagram->getDestAddress();
 
     // handle "forwarding" of packets during handover
-    MacNodeId destId = binder_->getMacNodeId(destAddr);
-    if (hoForwarding_.find(destId) != hoForwarding_.end())
+    MacNodeId destId = getFlowInfo(datagram->getSrcAddress(), destAddr).destId;
+    std::unordered_map<MacNodeId, MacNodeId>::iterator fwdIt = hoForwarding_.find(destId);
+    if (fwdIt != hoForwarding_.end())
     {
         // data packet must be forwarded (via X2) to another eNB
-        MacNodeId targetEnb = hoForwarding_.at(destId);
+        MacNodeId targetEnb = fwdIt->second;
         sendTunneledPacketOnHandover(pkt, targetEnb);
         return;
     }
@@ -283,12 +298,6 @@ void IP2lte::fromIpEnb(Packet * pkt)
     if (hoHolding_.find(destId) != hoHolding_.end())
     {
         // hold packets until handover is complete
-        if (hoFromIp_.find(destId) == hoFromIp_.end())
-        {
-            IpDatagramQueue queue;
-            hoFromIp_[destId] = queue;
-        }
-
         hoFromIp_[destId].push_back(pkt);
         return;
     }
@@ -324,12 +333,7 @@ void IP2lte::toStackEnb(Packet* pkt)
 
 
     // if needed, create a new structure for the flow
-    AddressPair pair(srcAddr, destAddr);
-    if (seqNums_.find(pair) == seqNums_.end())
-    {
-        std::pair<AddressPair, unsigned int> p(pair, 0);
-        seqNums_.insert(p);
-    }
+    FlowInfo& flow = getFlowInfo(srcAddr, destAddr);
 
 
     switch(transportProtocol)
@@ -352,12 +356,11 @@ void IP2lte::toStackEnb(Packet* pkt)
     pkt->addTagIfAbsent<FlowControlInfo>()->setSrcAddr(srcAddr.getInt());
     pkt->addTagIfAbsent<FlowControlInfo>()->setDstAddr(destAddr.getInt());
     pkt->addTagIfAbsent<FlowControlInfo>()->setTypeOfService(tos);
-    pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(seqNums_[pair]++);
+    pkt->addTagIfAbsent<FlowControlInfo>()->setSequenceNumber(flow.seqNum++);
     pkt->addTagIfAbsent<FlowControlInfo>()->setHeaderSize(headerSize);
 
     // TODO Relay management should be placed here
-    MacNodeId destId = binder_->getMacNodeId(destAddr);
-    MacNodeId master = binder_->getNextHop(destId);
+    MacNodeId master = binder_->getNextHop(flow.destId);
 
     pkt->addTagIfAbsent<FlowControlInfo>()->setDestId(master);
     printControlInfo(pkt);
@@ -452,16 +455,21 @@ void IP2lte::sendTunneledPacketOnHandover(Packet* datagram, MacNodeId targetEnb)
 
 void IP2lte::receiveTunneledPacketOnHandover(Packet* datagram, MacNodeId sourceEnb)
 {
+    Enter_Method("receiveTunneledPacketOnHandover");
+
     EV << "IP2lte::receiveTunneledPacketOnHandover - received packet via X2 from " << sourceEnb << endl;
     const auto& hdr = datagram->peekAtFront<Ipv4Header>();
     const Ipv4Address& destAddr = hdr->getDestAddress();
     MacNodeId destId = binder_->getMacNodeId(destAddr);
-    if (hoFromX2_.find(destId) == hoFromX2_.end())
+
+    if (hoHolding_.find(destId) == hoHolding_.end())
     {
-        IpDatagramQueue queue;
-        hoFromX2_[destId] = queue;
+        // the handover is already complete (e.g. the packet was delayed by X2 batching): send it down
+        take(datagram);
+        datagram->trim();
+        toStackEnb(datagram);
+        return;
     }
-
     hoFromX2_[destId].push_back(datagram);
 }
 
@@ -485,7 +493,7 @@ void IP2lte::signalHandoverCompleteTarget(MacNodeId ueId, MacNodeId sourceEnb)
     // 1) packets received from X2
     // 2) packets received from IP
 
-    std::map<MacNodeId, IpDatagramQueue>::iterator it;
+    std::unordered_map<MacNodeId, IpDatagramQueue>::iterator it;
 
     it = hoFromX2_.find(ueId);
     if (it != hoFromX2_.end())
@@ -549,7 +557,7 @@ void IP2lte::signalHandoverCompleteUe()
 
 IP2lte::~IP2lte()
 {
-    std::map<MacNodeId, IpDatagramQueue>::iterator it;
+    std::unordered_map<MacNodeId, IpDatagramQueue>::iterator it;
     for (it = hoFromX2_.begin(); it != hoFromX2_.end(); ++it)
     {
         while (!it->second.empty())
@@ -11,6 +11,9 @@
 #define __SIMULTE_IP2LTE_H_
 
 #include <omnetpp.h>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <inet/networklayer/common/NetworkInterface.h>
 
 #include "common/LteCommon.h"
@@ -20,9 +23,6 @@
 
 class LteHandoverManager;
 
-// a sort of five-tuple with only two elements (a two-tuple...), src and dst addresses
-typedef std::pair<inet::Ipv4Address, inet::Ipv4Address> AddressPair;
-
 /**
  *
  */
@@ -34,9 +34,20 @@ protected:
 
     LteNodeType nodeType_;      // node type: can be ENODEB, UE
 
-    // datagram sequence numbers (one for each flow)
-    // TODO move numbering to PDCP
-    std::map<AddressPair, unsigned int> seqNums_;
+    // state of a flow, identified by its (source, destination) addresses pair
+    struct FlowInfo
+    {
+        // datagram sequence number
+        // TODO move numbering to PDCP
+        unsigned int seqNum;
+        // MacNodeId of the destination, as resolved by the binder
+        MacNodeId destId;
+        // version of the binder address table destId has been resolved with
+        unsigned int addressMapVersion;
+    };
+
+    // flows state, indexed by the integer values of the source and destination addresses
+    std::unordered_map<uint64_t, FlowInfo> flows_;
 
     // obsolete with the above map
     unsigned int seqNum_;       // datagram sequence number (RLC fragmentation needs it)
@@ -57,17 +68,24 @@ protected:
     // manager for the handover
     LteHandoverManager* hoManager_;
     // store the pair <ue,target_enb> for temporary forwarding of data during handover
-    std::map<MacNodeId, MacNodeId> hoForwarding_;
+    std::unordered_map<MacNodeId, MacNodeId> hoForwarding_;
     // store the UEs for temporary holding of data received over X2 during handover
-    std::set<MacNodeId> hoHolding_;
+    std::unordered_set<MacNodeId> hoHolding_;
 
-    typedef std::list<inet::Packet*> IpDatagramQueue;
-    std::map<MacNodeId, IpDatagramQueue> hoFromX2_;
-    std::map<MacNodeId, IpDatagramQueue> hoFromIp_;
+    typedef std::deque<inet::Packet*> IpDatagramQueue;
+    std::unordered_map<MacNodeId, IpDatagramQueue> hoFromX2_;
+    std::unordered_map<MacNodeId, IpDatagramQueue> hoFromIp_;
 
     bool ueHold_;
     IpDatagramQueue ueHoldFromIp_;
   protected:
+    /**
+     * Return the state of the flow with the given addresses, creating it if needed.
+     * The destination MacNodeId is resolved again only if the binder address table
+     * changed since the last packet of the flow
+     */
+    FlowInfo& getFlowInfo(const inet::Ipv4Address& srcAddr, const inet::Ipv4Address& destAddr);
+
     /**
      * Handle packets from transport layer and forward them to the stack
      */
@@ -0,0 +1,168 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "epc/EpcTableFile.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace omnetpp;
+
+const char EpcTableFile::SIGNATURE[8] = { 'L', 'T', 'E', 'T', 'A', 'B', 'L', '\0' };
+
+EpcTableFile::EpcTableFile(const char* fileName, TableType type)
+{
+    fileName_ = fileName;
+    data_ = nullptr;
+    length_ = 0;
+
+#if defined(_WIN32)
+    // no memory mapping, read the whole file at once
+    std::ifstream in(fileName, std::ios::binary | std::ios::ate);
+    if (!in)
+        throw cRuntimeError("EpcTableFile: cannot open file %s", fileName);
+    length_ = in.tellg();
+    data_ = malloc(length_ > 0 ? length_ : 1);
+    in.seekg(0);
+    if (!in.read(static_cast<char*>(data_), length_))
+        throw cRuntimeError("EpcTableFile: cannot read file %s", fileName);
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+        throw cRuntimeError("EpcTableFile: cannot open file %s: %s", fileName, strerror(errno));
+    struct stat st;
+    if (fstat(fd, &st) < 0)
+    {
+        close(fd);
+        throw cRuntimeError("EpcTableFile: cannot read file %s: %s", fileName, strerror(errno));
+    }
+    length_ = st.st_size;
+    if (length_ > 0)
+    {
+        data_ = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data_ == MAP_FAILED)
+        {
+            data_ = nullptr;
+            close(fd);
+            throw cRuntimeError("EpcTableFile: cannot map file %s: %s", fileName, strerror(errno));
+        }
+    }
+    close(fd);
+#endif
+
+    // validate the header
+    if (length_ < sizeof(Header))
+        throw cRuntimeError("EpcTableFile: file %s is too short", fileName);
+    const Header* header = static_cast<const Header*>(data_);
+    if (memcmp(header->signature, SIGNATURE, sizeof(SIGNATURE)) != 0)
+        throw cRuntimeError("EpcTableFile: file %s is not a binary table", fileName);
+    if (header->version != VERSION)
+        throw cRuntimeError("EpcTableFile: file %s has an unsupported version or byte order", fileName);
+    if (header->type != (uint32_t)type)
+        throw cRuntimeError("EpcTableFile: file %s contains a table of type %d, expected %d", fileName, header->type, type);
+
+    uint32_t recordSize = (type == FILTER_TABLE) ? sizeof(FilterRecord) : sizeof(LabelRecord);
+    if (header->recordSize != recordSize)
+        throw cRuntimeError("EpcTableFile: file %s has records of %d bytes, expected %d", fileName, header->recordSize, recordSize);
+    if (length_ != sizeof(Header) + (size_t)header->count * recordSize)
+        throw cRuntimeError("EpcTableFile: file %s is truncated or corrupted", fileName);
+
+    count_ = header->count;
+    records_ = static_cast<const char*>(data_) + sizeof(Header);
+}
+
+EpcTableFile::~EpcTableFile()
+{
+    if (data_ == nullptr)
+        return;
+#if defined(_WIN32)
+    free(data_);
+#else
+    munmap(data_, length_);
+#endif
+}
+
+bool EpcTableFile::isBinaryTable(const char* fileName)
+{
+    FILE* f = fopen(fileName, "rb");
+    if (f == nullptr)
+        return false;
+    char signature[sizeof(SIGNATURE)];
+    bool ret = (fread(signature, 1, sizeof(signature), f) == sizeof(signature)
+        && memcmp(signature, SIGNATURE, sizeof(SIGNATURE)) == 0);
+    fclose(f);
+    return ret;
+}
+
+void EpcTableFile::write(const char* fileName, TableType type, const std::vector<LabelRecord>& records)
+{
+    if (type == FILTER_TABLE)
+        throw cRuntimeError("EpcTableFile::write - label records cannot be written as a filter table");
+    write(fileName, type, records.data(), sizeof(LabelRecord), records.size());
+}
+
+void EpcTableFile::write(const char* fileName, const std::vector<FilterRecord>& records)
+{
+    write(fileName, FILTER_TABLE, records.data(), sizeof(FilterRecord), records.size());
+}
+
+void EpcTableFile::write(const char* fileName, TableType type, const void* records, uint32_t recordSize, uint32_t count)
+{
+    Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.signature, SIGNATURE, sizeof(SIGNATURE));
+    header.version = VERSION;
+    header.type = type;
+    header.recordSize = recordSize;
+    header.count = count;
+
+    FILE* f = fopen(fileName, "wb");
+    if (f == nullptr)
+        throw cRuntimeError("EpcTableFile::write - cannot open file %s: %s", fileName, strerror(errno));
+    bool ok = (fwrite(&header, sizeof(header), 1, f) == 1);
+    if (ok && count > 0)
+        ok = (fwrite(records, recordSize, count, f) == count);
+    if (fclose(f) != 0)
+        ok = false;
+    if (!ok)
+        throw cRuntimeError("EpcTableFile::write - error writing file %s", fileName);
+
+    EV << "EpcTableFile::write - written " << count << " entries to " << fileName << endl;
+}
+
+int EpcTableFile::parseInt(cXMLElement* entry, const char* attr, const char* value)
+{
+    char* end;
+    errno = 0;
+    long v = strtol(value, &end, 10);
+    while (*end == ' ' || *end == '\t')
+        ++end;
+    if (end == value || *end != '\0' || errno != 0 || v < INT32_MIN || v > INT32_MAX)
+        throw cRuntimeError("Invalid value \"%s\" for attribute %s at %s", value, attr, entry->getSourceLocation());
+    return (int)v;
+}
+
+inet::Ipv4Address EpcTableFile::parseIpv4(cXMLElement* entry, const char* attr, const char* value)
+{
+    inet::Ipv4Address address;
+    if (!address.tryParse(value))
+        throw cRuntimeError("Invalid IPv4 address \"%s\" for attribute %s at %s", value, attr, entry->getSourceLocation());
+    return address;
+}
@@ -0,0 +1,139 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_EPCTABLEFILE_H_
+#define _LTE_EPCTABLEFILE_H_
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <inet/networklayer/contract/ipv4/Ipv4Address.h>
+#include "common/LteCommon.h"
+
+/**
+ * Compact binary format of the EPC configuration tables (GtpUser teidTable and tftTable,
+ * TrafficFlowFilter filterTable), meant for large tables that would take a long time to be
+ * parsed from XML at each run.
+ *
+ * A file is made of a header followed by an array of fixed-size records, with the same layout
+ * they have in memory. The file is memory-mapped, and the records are read in place while
+ * filling the lookup tables: no parsing nor per-record allocation is needed.
+ * Values are stored with the byte order of the host that wrote the file: files written on a
+ * host with a different byte order are rejected.
+ *
+ * Binary files are written by the modules themselves, when the convertTables parameter is set:
+ * the tables read from the XML file <name> are saved in <name>.bin. Filter tables are stored
+ * after host names have been resolved, hence they are only valid for the network configuration
+ * they were generated with.
+ */
+class SIMULTE_API EpcTableFile
+{
+  public:
+    enum TableType
+    {
+        TEID_TABLE = 1, TFT_TABLE = 2, FILTER_TABLE = 3
+    };
+
+    /**
+     * Entry of a teidTable (key is the incoming TEID) or of a tftTable (key is the TFT id)
+     */
+    struct LabelRecord
+    {
+        int32_t key;
+        int32_t teid;
+        uint32_t nextHop;   // IPv4 address
+    };
+
+    /**
+     * Entry of a filterTable, as inserted into the filter (addresses already resolved)
+     */
+    struct FilterRecord
+    {
+        int32_t tftId;
+        uint32_t firstKey;  // IPv4 address
+        uint32_t addr;      // IPv4 address
+        uint32_t srcPort;
+        uint32_t destPort;
+    };
+
+    /**
+     * Map the given file, checking that it contains a table of the given type
+     */
+    EpcTableFile(const char* fileName, TableType type);
+    virtual ~EpcTableFile();
+
+    /**
+     * @return true if the given file starts with the signature of a binary table
+     */
+    static bool isBinaryTable(const char* fileName);
+
+    unsigned int size() const
+    {
+        return count_;
+    }
+
+    const LabelRecord& getLabel(unsigned int i) const
+    {
+        return static_cast<const LabelRecord*>(records_)[i];
+    }
+
+    const FilterRecord& getFilter(unsigned int i) const
+    {
+        return static_cast<const FilterRecord*>(records_)[i];
+    }
+
+    /**
+     * Write a teidTable or a tftTable
+     */
+    static void write(const char* fileName, TableType type, const std::vector<LabelRecord>& records);
+
+    /**
+     * Write a filterTable
+     */
+    static void write(const char* fileName, const std::vector<FilterRecord>& records);
+
+    /**
+     * Parse an integer attribute of a XML table entry, throwing an error
+     * (with the position in the file) if it is not a valid integer
+     */
+    static int parseInt(omnetpp::cXMLElement* entry, const char* attr, const char* value);
+
+    /**
+     * Parse an IPv4 address attribute of a XML table entry, throwing an error
+     * (with the position in the file) if it is not a valid address
+     */
+    static inet::Ipv4Address parseIpv4(omnetpp::cXMLElement* entry, const char* attr, const char* value);
+
+  protected:
+    struct Header
+    {
+        char signature[8];
+        uint32_t version;
+        uint32_t type;
+        uint32_t recordSize;
+        uint32_t count;
+    };
+
+    static const char SIGNATURE[8];
+    static const uint32_t VERSION = 1;
+
+    static void write(const char* fileName, TableType type, const void* records, uint32_t recordSize, uint32_t count);
+
+    std::string fileName_;
+
+    // mapped file
+    void* data_;
+    size_t length_;
+
+    // first record and number of records
+    const void* records_;
+    unsigned int count_;
+};
+
+#endif
@@ -8,6 +8,7 @@
 //
 
 #include "epc/TrafficFlowFilter.h"
+#include "epc/EpcTableFile.h"
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include <inet/networklayer/ipv4/Ipv4Header_m.h>
 #include <inet/common/IProtocolRegistrationListener.h>
@@ -109,53 +110,37 @@ void TrafficFlowFilter::handleMessage(cMessage *msg)
     send(pkt,"gtpUserGateOut");
 }
 
-TrafficFlowTemplateId TrafficFlowFilter::findTrafficFlow(L3Address firstKey, TrafficFlowTemplate secondKey)
+TrafficFlowTemplateId TrafficFlowFilter::lookupTrafficFlow(const L3Address& firstKey, const L3Address& addr, unsigned int srcPort, unsigned int destPort) const
 {
-    TrafficFilterTemplateTable::iterator tftIt;
-    tftIt = filterTable_.find(firstKey);
-
-    // if no entry found
-    if (tftIt == filterTable_.end())
-    {
-        EV << "TrafficFlowFilter::findTrafficFlow - Cannot find tft list for destAddress " << firstKey << "." << endl;
-        return UNSPECIFIED_TFT;
-    }
-
-        // obtain the filter list associated to the given address
-    TrafficFilterTemplateList & filterList = tftIt->second;
+    FilterKey key = { firstKey, addr, srcPort, destPort };
+    CompiledFilterTable::const_iterator it = filterTable_.find(key);
+    return (it != filterTable_.end()) ? it->second : UNSPECIFIED_TFT;
+}
 
-    // search for the second key within the list
-    TrafficFilterTemplateList::iterator templIt = filterList.begin(),
-        templFirst = filterList.begin(),
-        templEt = filterList.end();
+TrafficFlowTemplateId TrafficFlowFilter::findTrafficFlow(L3Address firstKey, TrafficFlowTemplate secondKey)
+{
+    TrafficFlowTemplateId tftId;
 
     // try searching for the full entry (src-dest addresses and ports)
-    for (templIt = templFirst; templIt != templEt; templIt++)
-    {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
-    }
+    if ((tftId = lookupTrafficFlow(firstKey, secondKey.addr, secondKey.srcPort, secondKey.destPort)) != UNSPECIFIED_TFT)
+        return tftId;
     EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for the 4-tuple. Now trying with src and dest addresses" << endl;
 
     // if no result is found, try leaving port fields unspecified
-    secondKey.srcPort = secondKey.destPort = UNSPECIFIED_PORT;
-    for (templIt = templFirst; templIt != templEt; templIt++)
+    if (secondKey.srcPort != UNSPECIFIED_PORT || secondKey.destPort != UNSPECIFIED_PORT)
     {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
+        if ((tftId = lookupTrafficFlow(firstKey, secondKey.addr, UNSPECIFIED_PORT, UNSPECIFIED_PORT)) != UNSPECIFIED_TFT)
+            return tftId;
     }
     EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for src and dest addresses. Now trying with first key only" << endl;
 
     // if no result is found again, search only for the first key
-    secondKey.addr.set(Ipv4Address("0.0.0.0"));
-    for (templIt = templFirst; templIt != templEt; templIt++)
-    {
-        if ((*templIt) == secondKey)
-            return templIt->tftId;
-    }
+    L3Address unspecifiedAddr(Ipv4Address("0.0.0.0"));
+    if ((tftId = lookupTrafficFlow(firstKey, unspecifiedAddr, UNSPECIFIED_PORT, UNSPECIFIED_PORT)) != UNSPECIFIED_TFT)
+        return tftId;
 
     EV << "TrafficFlowFilter::findTrafficFlow - Cannot find entry for destAddress " << firstKey << " and values: ["
-       << secondKey.addr << "," << secondKey.destPort << "," << secondKey.srcPort << "]" << endl;
+       << unspecifiedAddr << "," << UNSPECIFIED_PORT << "," << UNSPECIFIED_PORT << "]" << endl;
 
     return UNSPECIFIED_TFT;
 }
@@ -174,14 +159,38 @@ bool TrafficFlowFilter::addTrafficFlow(L3Address firstKey, TrafficFlowTemplate t
         return false;
     }
 
-    filterTable_[firstKey].push_back(tft);
+    // entries with the same keys as a previous one are never selected
+    FilterKey key = { firstKey, tft.addr, tft.srcPort, tft.destPort };
+    filterTable_.emplace(key, tft.tftId);
 
     EV << "TrafficFlowFilter::addTrafficFlow - inserted entry: destAddr[" << firstKey << "] - TFT[" << tft.tftId << "]" << endl;
     return true;
 }
 
+void TrafficFlowFilter::loadBinaryFilterTable(const char * filterTableFile)
+{
+    EV << "TrafficFlowFilter::loadBinaryFilterTable - reading file " << filterTableFile << endl;
+    EpcTableFile file(filterTableFile, EpcTableFile::FILTER_TABLE);
+
+    filterTable_.reserve(filterTable_.size() + file.size());
+    for (unsigned int i = 0; i < file.size(); ++i)
+    {
+        const EpcTableFile::FilterRecord& record = file.getFilter(i);
+        TrafficFlowTemplate tft(L3Address(Ipv4Address(record.addr)), record.srcPort, record.destPort);
+        tft.tftId = record.tftId;
+        addTrafficFlow(L3Address(Ipv4Address(record.firstKey)), tft);
+    }
+    EV << "TrafficFlowFilter::loadBinaryFilterTable - loaded " << file.size() << " entries" << endl;
+}
+
 void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
 {
+    if (EpcTableFile::isBinaryTable(filterTableFile))
+    {
+        loadBinaryFilterTable(filterTableFile);
+        return;
+    }
+
     // create default entries
     L3Address destAddr(Ipv4Address("0.0.0.0")), srcAddr(Ipv4Address("0.0.0.0"));
     unsigned int destPort = UNSPECIFIED_PORT;
@@ -203,6 +212,10 @@ void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
     // attribute iterator
     unsigned int attrId = 0;
 
+    // entries to be saved in binary format
+    bool convertTables = par("convertTables").boolValue();
+    std::vector<EpcTableFile::FilterRecord> records;
+
     // open and check xml file
     EV << "TrafficFlowFilter::loadFilterTable - reading file " << filterTableFile << endl;
     cXMLElement* config = getEnvir()->getXMLDocument(filterTableFile);
@@ -245,13 +258,13 @@ void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
                     "TrafficFlowFilter::loadFilterTable - attribute tftId MUST be specified for every traffic filter.");
             }
             else
-                tftId = atoi(temp[TFT_ID]);
+                tftId = EpcTableFile::parseInt(*tftIt, attributes[TFT_ID], temp[TFT_ID]);
 
             // read src and dest port values. These two fields are optional
             if (temp[DEST_PORT] != nullptr)
-                destPort = atoi(temp[DEST_PORT]);
+                destPort = EpcTableFile::parseInt(*tftIt, attributes[DEST_PORT], temp[DEST_PORT]);
             if (temp[SRC_PORT] != nullptr)
-                srcPort = atoi(temp[SRC_PORT]);
+                srcPort = EpcTableFile::parseInt(*tftIt, attributes[SRC_PORT], temp[SRC_PORT]);
 
             //===================== Source and Destination addresses management =====================
             // NOTE that the behavior of this part depends on the node type of trafficFlowFilter owner:
@@ -261,7 +274,7 @@ void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
             // at least one between destAddr and destName MUST be specified in case of PGW
             // try to read the destination address for first
             if (temp[DEST_ADDR] != nullptr)
-                destAddr.set(Ipv4Address(temp[DEST_ADDR]));
+                destAddr.set(EpcTableFile::parseIpv4(*tftIt, attributes[DEST_ADDR], temp[DEST_ADDR]));
             else // if no dest address has been specified, try to resolve node name
             {
                 if (temp[DEST_NAME] != nullptr)
@@ -276,7 +289,7 @@ void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
                     // at least one between srcAddr and srcName MUST be specified in case of ENB
                     // try to read the source address for first
             if (temp[SRC_ADDR] != nullptr)
-                srcAddr.set(Ipv4Address(temp[SRC_ADDR]));
+                srcAddr.set(EpcTableFile::parseIpv4(*tftIt, attributes[SRC_ADDR], temp[SRC_ADDR]));
             else // if no src address has been specified, try to resolve node name
             {
                 if (temp[SRC_NAME] != nullptr)
@@ -308,8 +321,18 @@ void TrafficFlowFilter::loadFilterTable(const char * filterTableFile)
             // TODO decide what to do in case of duplicate entries
             if (!addTrafficFlow(primaryKey, secondaryKey))
                 ;
-            else
-                ;
+            else if (convertTables)
+            {
+                // the entry is saved as inserted, i.e. with resolved addresses
+                if (primaryKey.getType() != L3Address::IPv4 || secondaryKeyAddr.getType() != L3Address::IPv4)
+                    error("TrafficFlowFilter::loadFilterTable - only IPv4 entries can be converted, tftID[%i]", tftId);
+                EpcTableFile::FilterRecord record = { (int32_t)tftId, primaryKey.toIpv4().getInt(),
+                    secondaryKeyAddr.toIpv4().getInt(), secondaryKey.srcPort, secondaryKey.destPort };
+                records.push_back(record);
+            }
         }
     }
+
+    if (convertTables)
+        EpcTableFile::write((std::string(filterTableFile) + ".bin").c_str(), records);
 }
@@ -11,6 +11,7 @@
 #define _LTE_TRAFFICFLOWFILTER_H_
 
 #include <omnetpp.h>
+#include <unordered_map>
 
 #include <inet/common/packet/Packet.h>
 
@@ -32,6 +33,10 @@
  * be left unspecified and a new search will be performed. In case of another failure a last search with only the first key will be performed.
  * If no result is found even in this case, an error will be thrown.
  *
+ * The table is compiled into a hash table indexed by the first key and all the fields of the TrafficFlowTemplate (with
+ * unspecified fields stored as such), hence each of the above searches is a single lookup. When more entries have
+ * the same keys, the first one loaded is used.
+ *
  * This table is specified via (part of) a XML configuration file. Note that the fields of the TrafficFlowTemplates (except for the tftId) may
  * be left unspecified
  *
@@ -59,6 +64,9 @@
  * must be specified.
  * In case of both "destName" and "destAddr" values, the "destAddr" will be used
  *
+ * Large tables can be converted to a binary format (see EpcTableFile and the convertTables parameter),
+ * which is loaded without parsing nor resolving host names
+ *
  */
 class SIMULTE_API TrafficFlowFilter : public omnetpp::cSimpleModule
 {
@@ -69,10 +77,52 @@ class SIMULTE_API TrafficFlowFilter : public omnetpp::cSimpleModule
     // gate for connecting with the GTP-U module
     // omnetpp::cGate * gtpUserGate_;
 
-    TrafficFilterTemplateTable filterTable_;
+    // key of the compiled filter table: the first key and the fields of a TrafficFlowTemplate
+    struct FilterKey
+    {
+        inet::L3Address firstKey;
+        inet::L3Address addr;
+        unsigned int srcPort;
+        unsigned int destPort;
+
+        bool operator==(const FilterKey& other) const
+        {
+            return firstKey == other.firstKey && addr == other.addr && srcPort == other.srcPort && destPort == other.destPort;
+        }
+    };
+
+    struct FilterKeyHash
+    {
+        static size_t hashAddress(const inet::L3Address& address)
+        {
+            if (address.getType() == inet::L3Address::IPv4)
+                return address.toIpv4().getInt();
+            return std::hash<std::string>()(address.str());
+        }
+
+        size_t operator()(const FilterKey& key) const
+        {
+            size_t h = hashAddress(key.firstKey);
+            h = h * 31 + hashAddress(key.addr);
+            h = h * 31 + key.srcPort;
+            h = h * 31 + key.destPort;
+            return h;
+        }
+    };
+
+    typedef std::unordered_map<FilterKey, TrafficFlowTemplateId, FilterKeyHash> CompiledFilterTable;
+
+    // compiled filter table
+    CompiledFilterTable filterTable_;
+
+    // return the tftId of the entry exactly matching the given keys, UNSPECIFIED_TFT if none
+    TrafficFlowTemplateId lookupTrafficFlow(const inet::L3Address& firstKey, const inet::L3Address& addr, unsigned int srcPort, unsigned int destPort) const;
 
     void loadFilterTable(const char * filterTableFile);
 
+    // fill the filter table from a binary table file (see EpcTableFile)
+    void loadBinaryFilterTable(const char * filterTableFile);
+
     EpcNodeType selectOwnerType(const char * type);
     protected:
     virtual int numInitStages() const override { return inet::NUM_INIT_STAGES; }
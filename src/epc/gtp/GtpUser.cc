@@ -16,6 +16,20 @@
 Define_Module(GtpUser);
 using namespace inet;
 
+// length of the entry of a packet in the header of a bundle, in bytes (length field)
+static const int GTP_BUNDLE_ENTRY_LENGTH = 2;
+
+GtpUser::~GtpUser()
+{
+    std::map<L3Address, GtpBundle>::iterator it = bundles_.begin();
+    for (; it != bundles_.end(); ++it)
+    {
+        for (unsigned int i = 0; i < it->second.pdus.size(); i++)
+            delete it->second.pdus[i];
+        cancelAndDelete(it->second.flushTimer);
+    }
+}
+
 void GtpUser::initialize(int stage) {
     cSimpleModule::initialize(stage);
 
@@ -28,6 +42,8 @@ void GtpUser::initialize(int stage) {
     socket_.bind(localPort_);
 
     tunnelPeerPort_ = par("tunnelPeerPort");
+    batchingWindow_ = par("batchingWindow");
+    maxBundleLength_ = B(par("maxBundleLength").intValue());
 
     ownerType_ = selectOwnerType(getAncestorPar("nodeType"));
 
@@ -86,6 +102,10 @@ EpcNodeType GtpUser::selectOwnerType(const char * type)
 }
 
 void GtpUser::handleMessage(cMessage *msg) {
+    if (msg->isSelfMessage()) {
+        flushBundle(*static_cast<GtpBundle*>(msg->getContextPointer()));
+        return;
+    }
     if (strcmp(msg->getArrivalGate()->getFullName(), "trafficFlowFilterGate")
             == 0) {
         EV << "GtpUser::handleMessage - message from trafficFlowFilter" << endl;
@@ -101,15 +121,18 @@ void GtpUser::handleMessage(cMessage *msg) {
         EV << "GtpUser::handleMessage - message from udp layer" << endl;
         auto pkt = check_and_cast<Packet*>(msg);
         pkt->trim();
-        auto ipDatagram = pkt->peekAtFront<GtpUserMsg>();
-        handleFromUdp(pkt);
+        auto chunk = pkt->peekAtFront<Chunk>();
+        if (dynamicPtrCast<const GtpUserBundle>(chunk) != nullptr)
+            handleBundle(pkt);
+        else
+            handleFromUdp(pkt);
     }
 }
 
 void GtpUser::handleFromTrafficFlowFilter(Packet *pkt) {
     // extract control info from the datagram
-    auto tftInfo = pkt->removeTag<TftControlInfo>();
-    TrafficFlowTemplateId flowId = tftInfo->getTft();
+    auto tftControlInfo = pkt->removeTag<TftControlInfo>();
+    TrafficFlowTemplateId flowId = tftControlInfo->getTft();
     //delete tftInfo;
     removeAllSimuLteTags(pkt);
 
@@ -120,16 +143,15 @@ void GtpUser::handleFromTrafficFlowFilter(Packet *pkt) {
     L3Address tunnelPeerAddress;
 
     // search a correspondence between the flow id and the pair <teid,nextHop>
-    LabelTable::iterator tftIt;
-    tftIt = tftTable_.find(flowId);
-    if (tftIt == tftTable_.end()) {
+    const ConnectionInfo* tftInfo = tftTable_.find(flowId);
+    if (tftInfo == nullptr) {
         EV
                   << "GtpUser::handleFromTrafficFlowFilter - Cannot find entry for TFT "
                   << flowId << ". Discarding packet;" << endl;
         return;
     }
-    tunnelPeerAddress = tftIt->second.nextHop;
-    nextTeid = tftIt->second.teid;
+    tunnelPeerAddress = tftInfo->nextHop;
+    nextTeid = tftInfo->teid;
 
     // create a new gtpUserMessage
     auto gtpMsg = makeShared<GtpUserMsg>();
@@ -141,8 +163,7 @@ void GtpUser::handleFromTrafficFlowFilter(Packet *pkt) {
     pkt->insertAtFront(gtpMsg);
     pkt->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::gtp);
 
-
-    socket_.sendTo(pkt, tunnelPeerAddress, tunnelPeerPort_);
+    sendToTunnelPeer(pkt, tunnelPeerAddress);
 }
 
 void GtpUser::handleFromUdp(Packet *pkt) {
@@ -161,14 +182,14 @@ void GtpUser::handleFromUdp(Packet *pkt) {
     oldTeid = gtpMsg->getTeid();
 
     // obtain "ConnectionInfo" from the teidTable
-    LabelTable::iterator teidIt = teidTable_.find(oldTeid);
-    if (teidIt == teidTable_.end()) {
+    const ConnectionInfo* teidEntry = teidTable_.find(oldTeid);
+    if (teidEntry == nullptr) {
         EV << "GtpUser::handleFromUdp - Cannot find entry for TEID " << oldTeid
                   << ". Discarding packet;" << endl;
         delete pkt;
         return;
     }
-    ConnectionInfo teidInfo = teidIt->second;
+    ConnectionInfo teidInfo = *teidEntry;
 
     // decide here whether performing a label switching or a label removal
     if (teidInfo.teid == LOCAL_ADDRESS_TEID) // tunneling ended.
@@ -196,14 +217,115 @@ void GtpUser::handleFromUdp(Packet *pkt) {
         gtpMsg->setTeid(teidInfo.teid);
         pkt->insertAtFront(gtpMsg);
         removeAllSimuLteTags(pkt);
-        socket_.sendTo(pkt, teidInfo.nextHop, tunnelPeerPort_);
+        sendToTunnelPeer(pkt, teidInfo.nextHop);
+    }
+}
+
+void GtpUser::sendToTunnelPeer(Packet *pkt, const L3Address& peer) {
+    if (batchingWindow_ == 0) {
+        socket_.sendTo(pkt, peer, tunnelPeerPort_);
+        return;
+    }
+
+    GtpBundle& bundle = bundles_[peer];
+    if (bundle.flushTimer == nullptr) {
+        bundle.peer = peer;
+        bundle.flushTimer = new cMessage("gtpBundleTimer");
+        bundle.flushTimer->setContextPointer(&bundle);
     }
+
+    // the bundle, including its header, must fit in a single IP packet, to avoid fragmentation
+    if (!bundle.pdus.empty()
+            && bundle.length + pkt->getDataLength() + B(GTP_BUNDLE_ENTRY_LENGTH * (bundle.pdus.size() + 1)) > maxBundleLength_)
+        flushBundle(bundle);
+
+    // the batching window starts with the first packet of the bundle
+    if (bundle.pdus.empty())
+        scheduleAt(NOW + batchingWindow_, bundle.flushTimer);
+
+    bundle.pdus.push_back(pkt);
+    bundle.length += pkt->getDataLength();
+
+    EV << "GtpUser::sendToTunnelPeer - added packet " << pkt->getName()
+              << " to the bundle for " << peer << " ["
+              << bundle.pdus.size() << " packets]" << endl;
+}
+
+void GtpUser::flushBundle(GtpBundle& bundle) {
+    if (bundle.flushTimer->isScheduled())
+        cancelEvent(bundle.flushTimer);
+    if (bundle.pdus.empty())
+        return;
+
+    EV << "GtpUser::flushBundle - sending " << bundle.pdus.size()
+              << " packets to " << bundle.peer << endl;
+
+    if (bundle.pdus.size() == 1) {
+        socket_.sendTo(bundle.pdus.front(), bundle.peer, tunnelPeerPort_);
+    } else {
+        auto header = makeShared<GtpUserBundle>();
+        header->setPduLengthArraySize(bundle.pdus.size());
+        header->setPduNameArraySize(bundle.pdus.size());
+        header->setChunkLength(B(GTP_BUNDLE_ENTRY_LENGTH * bundle.pdus.size()));
+
+        Packet *pkt = new Packet("GtpUserBundle");
+        for (unsigned int i = 0; i < bundle.pdus.size(); i++) {
+            Packet *pdu = bundle.pdus[i];
+            header->setPduLength(i, B(pdu->getDataLength()).get());
+            header->setPduName(i, pdu->getName());
+            pkt->insertAtBack(pdu->peekData());
+            delete pdu;
+        }
+        pkt->insertAtFront(header);
+        pkt->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::gtp);
+        socket_.sendTo(pkt, bundle.peer, tunnelPeerPort_);
+    }
+    bundle.pdus.clear();
+    bundle.length = b(0);
+}
+
+void GtpUser::handleBundle(Packet *pkt) {
+    auto header = pkt->removeAtFront<GtpUserBundle>();
+
+    EV << "GtpUser::handleBundle - received a bundle of "
+              << header->getPduLengthArraySize() << " packets" << endl;
+
+    // each packet gets the indications of the UDP datagram, as if it was received alone
+    b offset = b(0);
+    for (unsigned int i = 0; i < header->getPduLengthArraySize(); i++) {
+        B length = B(header->getPduLength(i));
+        Packet *pdu = new Packet(header->getPduName(i), pkt->peekDataAt(offset, length));
+        pdu->copyTags(*pkt);
+        offset += length;
+        handleFromUdp(pdu);
+    }
+    delete pkt;
 }
 
 //==========================================================================
 //============================== XML MANAGEMENT ============================
 //==========================================================================
+void GtpUser::loadBinaryTable(const char *tableFile, EpcTableFile::TableType type, LabelTable& table) {
+    EV << "GtpUser::loadBinaryTable - reading file " << tableFile << endl;
+    EpcTableFile file(tableFile, type);
+
+    table.reserve(table.size() + file.size());
+    for (unsigned int i = 0; i < file.size(); ++i) {
+        const EpcTableFile::LabelRecord& record = file.getLabel(i);
+        L3Address nextHop(Ipv4Address(record.nextHop));
+        if (!table.insert(record.key, ConnectionInfo(record.teid, nextHop)))
+            EV << "GtpUser::loadBinaryTable - skipping duplicate entry with key "
+                      << record.key << endl;
+    }
+    EV << "GtpUser::loadBinaryTable - loaded " << file.size() << " entries" << endl;
+}
+
 bool GtpUser::loadTeidTable(const char *teidTableFile) {
+    if (EpcTableFile::isBinaryTable(teidTableFile)) {
+        loadBinaryTable(teidTableFile, EpcTableFile::TEID_TABLE, teidTable_);
+        return true;
+    }
+
     // open and check xml file
     EV << "GtpUser::loadTeidTable - reading file " << teidTableFile << endl;
     cXMLElement *config = getEnvir()->getXMLDocument(teidTableFile);
@@ -228,6 +350,9 @@ bool GtpUser::loadTeidTable(const char *teidTableFile) {
 
     char const *temp[numAttributes];
 
+    // entries to be saved in binary format
+    std::vector<EpcTableFile::LabelRecord> records;
+
     // foreach teid element in the list, read the parameters and fill the teid table
     for (cXMLElementList::iterator teidsIt = teidList.begin();
             teidsIt != teidList.end(); teidsIt++) {
@@ -247,30 +372,36 @@ bool GtpUser::loadTeidTable(const char *teidTableFile) {
                 }
             }
 
-            teidIn = atoi(temp[0]);
-            teidOut = atoi(temp[1]);
-            nextHop.set(Ipv4Address(temp[2]));
+            teidIn = EpcTableFile::parseInt(*teidsIt, attributes[0], temp[0]);
+            teidOut = EpcTableFile::parseInt(*teidsIt, attributes[1], temp[1]);
+            nextHop.set(EpcTableFile::parseIpv4(*teidsIt, attributes[2], temp[2]));
 
-            std::pair<LabelTable::iterator, bool> ret;
-            ret = teidTable_.insert(
-                    std::pair<TunnelEndpointIdentifier, ConnectionInfo>(teidIn,
-                            ConnectionInfo(teidOut, nextHop)));
-            ;
-            if (ret.second == false)
+            if (!teidTable_.insert(teidIn, ConnectionInfo(teidOut, nextHop)))
                 EV
                           << "GtpUser::loadTeidTable - skipping duplicate entry  with TEID "
-                          << ret.first->first << '\n';
-            else
+                          << teidIn << '\n';
+            else {
                 EV << "GtpUser::loadTeidTable - inserted entry: TEIDin["
                           << teidIn << "] - TEIDout[" << teidOut
                           << "] - NextHop[" << nextHop << "]" << endl;
+                EpcTableFile::LabelRecord record = { teidIn, teidOut, nextHop.toIpv4().getInt() };
+                records.push_back(record);
+            }
         }
     }
+
+    if (par("convertTables").boolValue())
+        EpcTableFile::write((std::string(teidTableFile) + ".bin").c_str(), EpcTableFile::TEID_TABLE, records);
     return true;
 }
 
 // TODO avoid replicating the xmlLoad code. Use an array of attributes as input and a array of strings as return
 bool GtpUser::loadTftTable(const char *tftTableFile) {
+    if (EpcTableFile::isBinaryTable(tftTableFile)) {
+        loadBinaryTable(tftTableFile, EpcTableFile::TFT_TABLE, tftTable_);
+        return true;
+    }
+
     // open and check xml file
     EV << "GtpUser::loadTftTable - reading file " << tftTableFile << endl;
     cXMLElement *config = getEnvir()->getXMLDocument(tftTableFile);
@@ -297,6 +428,9 @@ bool GtpUser::loadTftTable(const char *tftTableFile) {
 
     char const *temp[numAttributes];
 
+    // entries to be saved in binary format
+    std::vector<EpcTableFile::LabelRecord> records;
+
     // foreach TFT element in the list, read the parameters and fill the teid table
     for (cXMLElementList::iterator tftIt = tftList.begin();
             tftIt != tftList.end(); tftIt++) {
@@ -318,26 +452,27 @@ bool GtpUser::loadTftTable(const char *tftTableFile) {
             }
 
             // convert attributes
-            tft = atoi(temp[0]);
-            teidOut = atoi(temp[1]);
-            nextHop.set(Ipv4Address(temp[2]));
+            tft = EpcTableFile::parseInt(*tftIt, attributes[0], temp[0]);
+            teidOut = EpcTableFile::parseInt(*tftIt, attributes[1], temp[1]);
+            nextHop.set(EpcTableFile::parseIpv4(*tftIt, attributes[2], temp[2]));
 
             // create a new entry in the TEID table,
-            std::pair<LabelTable::iterator, bool> ret;
-            ret = tftTable_.insert(
-                    std::pair<TrafficFlowTemplateId, ConnectionInfo>(tft,
-                            ConnectionInfo(teidOut, nextHop)));
-            ;
-            if (ret.second == false)
+            if (!tftTable_.insert(tft, ConnectionInfo(teidOut, nextHop)))
                 EV
                           << "GtpUser::loadTftTable - skipping duplicate entry  with TFT "
-                          << ret.first->first << '\n';
-            else
+                          << tft << '\n';
+            else {
                 EV << "GtpUser::loadTtftTable - inserted entry: TFT[" << tft
                           << "] - TEIDout[" << teidOut << "] - NextHop["
                           << nextHop << "]" << endl;
+                EpcTableFile::LabelRecord record = { tft, teidOut, nextHop.toIpv4().getInt() };
+                records.push_back(record);
+            }
         }
     }
+
+    if (par("convertTables").boolValue())
+        EpcTableFile::write((std::string(tftTableFile) + ".bin").c_str(), EpcTableFile::TFT_TABLE, records);
     return true;
 }
 // ==========================================================================
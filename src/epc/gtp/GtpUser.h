@@ -19,7 +19,9 @@
 #include "epc/gtp/GtpUserMsg_m.h"
 
 #include <map>
+#include <vector>
 #include "epc/gtp_common.h"
+#include "epc/EpcTableFile.h"
 
 /**
  * GtpUser is used for building data tunnels between GTP peers.
@@ -36,7 +38,9 @@
  *      the value LOCAL_ADDRESS_TEID as defined in "gtp_common.h"
  *  - otherwise the GtpUserMsg will be sent in the GTP tunnel towards the chosen GTP peer
  *
- * The teidTable and tftTable are filled via XML configuration files. All fields are mandatory
+ * The teidTable and tftTable are filled via XML configuration files. All fields are mandatory.
+ * Large tables can be converted to a binary format (see EpcTableFile and the convertTables parameter),
+ * which is loaded without parsing
  *
  * Example format for teidTable
  <config>
@@ -92,6 +96,9 @@ class SIMULTE_API GtpUser : public omnetpp::cSimpleModule
     bool loadTeidTable(const char * teidTableFile);
     bool loadTftTable(const char * tftTableFile);
 
+    // fill a teidTable or tftTable from a binary table file (see EpcTableFile)
+    void loadBinaryTable(const char * tableFile, EpcTableFile::TableType type, LabelTable& table);
+
     // specifies the type of the node that contains this filter (it can be ENB or PGW)
     EpcNodeType ownerType_;
 
@@ -102,6 +109,43 @@ class SIMULTE_API GtpUser : public omnetpp::cSimpleModule
     inet::NetworkInterface* detectInterface();
     inet::NetworkInterface* ie_;
 
+    /*
+     * GTP-U packets sent towards the same tunnel peer within the batching window are carried
+     * by a single UDP datagram, so that the UDP/IP layers of both peers handle one event per
+     * tunnel peer and window, rather than one per packet. Each packet keeps its own GTP header.
+     * Batching is disabled if the window is zero
+     */
+    omnetpp::simtime_t batchingWindow_;
+    // maximum length of the UDP payload carrying a bundle (a larger packet is sent alone)
+    inet::b maxBundleLength_;
+
+    struct GtpBundle
+    {
+        GtpBundle() :
+            length(0), flushTimer(nullptr)
+        {
+        }
+        inet::L3Address peer;
+        std::vector<inet::Packet*> pdus;
+        inet::b length;
+        omnetpp::cMessage* flushTimer;
+    };
+
+    // pending bundles, one per tunnel peer
+    std::map<inet::L3Address, GtpBundle> bundles_;
+
+    // send a GTP-U packet towards the given tunnel peer, possibly adding it to the pending bundle
+    void sendToTunnelPeer(inet::Packet* pkt, const inet::L3Address& peer);
+
+    // send the packets of a bundle within a single UDP datagram
+    void flushBundle(GtpBundle& bundle);
+
+    // split a received bundle and handle each GTP-U packet
+    void handleBundle(inet::Packet* pkt);
+
+  public:
+    virtual ~GtpUser();
+
   protected:
 
     virtual int numInitStages() const { return inet::NUM_INIT_STAGES; }
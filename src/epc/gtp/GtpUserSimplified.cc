@@ -129,15 +129,26 @@ void GtpUserSimplified::handleFromTrafficFlowFilter(Packet * pkt)
         }
         else
         {
-            // get the symbolic IP address of the tunnel destination ID
-            // then obtain the address via IPvXAddressResolver
-            const char* symbolicName = binder_->getModuleNameByMacNodeId(flowId);
-            tunnelPeerAddress = L3AddressResolver().resolve(symbolicName);
+            tunnelPeerAddress = getTunnelPeerAddress(flowId);
         }
         socket_.sendTo(pkt, tunnelPeerAddress, tunnelPeerPort_);
     }
 }
 
+L3Address GtpUserSimplified::getTunnelPeerAddress(MacNodeId peerId)
+{
+    const L3Address* cached = peerAddressCache_.find(peerId);
+    if (cached != nullptr)
+        return *cached;
+
+    // get the symbolic IP address of the tunnel destination ID
+    // then obtain the address via IPvXAddressResolver
+    const char* symbolicName = binder_->getModuleNameByMacNodeId(peerId);
+    L3Address peerAddress = L3AddressResolver().resolve(symbolicName);
+    peerAddressCache_.insert(peerId, peerAddress);
+    return peerAddress;
+}
+
 void GtpUserSimplified::handleFromUdp(Packet *pkt)
 {
     EV << "GtpUserSimplified::handleFromUdp - Decapsulating datagram from GTP tunnel" << endl;
@@ -166,10 +177,9 @@ void GtpUserSimplified::handleFromUdp(Packet *pkt)
              pkt->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::gtp);
 
              MacNodeId destMaster = binder_->getNextHop(destId);
-             const char* symbolicName = binder_->getModuleNameByMacNodeId(destMaster);
-             L3Address tunnelPeerAddress = L3AddressResolver().resolve(symbolicName);
+             L3Address tunnelPeerAddress = getTunnelPeerAddress(destMaster);
              socket_.sendTo(pkt, tunnelPeerAddress, tunnelPeerPort_);
-             EV << "GtpUserSimplified::handleFromUdp - Destination is a MEC server. Sending GTP packet to " << symbolicName << endl;
+             EV << "GtpUserSimplified::handleFromUdp - Destination is a MEC server. Sending GTP packet to " << tunnelPeerAddress << endl;
         }
         else
         {
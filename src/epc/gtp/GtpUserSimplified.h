@@ -47,6 +47,12 @@ class SIMULTE_API GtpUserSimplified : public omnetpp::cSimpleModule
     // IP address of the PGW
     inet::L3Address pgwAddress_;
 
+    // IP addresses of the tunnel peers, indexed by their MAC node ID. Filled on first use
+    GtpHashTable<inet::L3Address> peerAddressCache_;
+
+    // return the IP address of the tunnel peer with the given MAC node ID
+    inet::L3Address getTunnelPeerAddress(MacNodeId peerId);
+
     // specifies the type of the node that contains this filter (it can be ENB or PGW)
     EpcNodeType ownerType_;
 
@@ -12,6 +12,8 @@
 
 #include <map>
 #include <list>
+#include <vector>
+#include <stdint.h>
 #include <inet/networklayer/common/L3Address.h>
 
 enum EpcNodeType
@@ -32,6 +34,11 @@ typedef int TunnelEndpointIdentifier;
 
 struct ConnectionInfo
 {
+    ConnectionInfo() :
+        teid(0)
+    {
+    }
+
     ConnectionInfo(TunnelEndpointIdentifier id, inet::L3Address hop) :
         teid(id), nextHop(hop)
     {
@@ -41,7 +48,130 @@ struct ConnectionInfo
     inet::L3Address nextHop;
 };
 
-typedef std::map<TunnelEndpointIdentifier, ConnectionInfo> LabelTable;
+/**
+ * Hash table indexed by integer identifiers (TEIDs, TFT identifiers, node ids).
+ *
+ * Entries are stored in a flat array using open addressing with linear probing,
+ * so that a lookup costs a hash computation and (on average) one or two probes
+ * within the same cache line. Entries are never removed, as the tables are
+ * filled at initialization or are used as caches of static information.
+ */
+template<typename T>
+class GtpHashTable
+{
+  public:
+    GtpHashTable()
+    {
+        slots_.resize(INITIAL_CAPACITY);
+        size_ = 0;
+    }
+
+    /**
+     * Insert a new entry.
+     * If an entry with the same key already exists, it is not modified
+     *
+     * @return false if the key was already in the table
+     */
+    bool insert(int key, const T& value)
+    {
+        unsigned int i = probe(key);
+        if (slots_[i].used)
+            return false;
+
+        // keep the load factor below 1/2
+        if (2 * (size_ + 1) > slots_.size())
+        {
+            rehash(slots_.size() * 2);
+            i = probe(key);
+        }
+        slots_[i].used = true;
+        slots_[i].key = key;
+        slots_[i].value = value;
+        ++size_;
+        return true;
+    }
+
+    /**
+     * @return the entry with the given key, nullptr if not found
+     */
+    T* find(int key)
+    {
+        unsigned int i = probe(key);
+        return slots_[i].used ? &slots_[i].value : nullptr;
+    }
+
+    const T* find(int key) const
+    {
+        unsigned int i = probe(key);
+        return slots_[i].used ? &slots_[i].value : nullptr;
+    }
+
+    /**
+     * Make room for the given number of entries, so that they are inserted without rehashing
+     */
+    void reserve(unsigned int n)
+    {
+        unsigned int capacity = slots_.size();
+        while (capacity < 2 * n)
+            capacity *= 2;
+        if (capacity > slots_.size())
+            rehash(capacity);
+    }
+
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+  protected:
+    static const unsigned int INITIAL_CAPACITY = 16;
+
+    struct Slot
+    {
+        Slot() :
+            used(false), key(0)
+        {
+        }
+        bool used;
+        int key;
+        T value;
+    };
+
+    // return the slot containing the key, or the free slot where it would be inserted
+    unsigned int probe(int key) const
+    {
+        unsigned int mask = slots_.size() - 1;
+        uint32_t h = (uint32_t)key * 2654435761u;
+        unsigned int i = (h ^ (h >> 16)) & mask;
+        while (slots_[i].used && slots_[i].key != key)
+            i = (i + 1) & mask;
+        return i;
+    }
+
+    // change the capacity (a power of two), re-inserting all the entries
+    void rehash(unsigned int capacity)
+    {
+        std::vector<Slot> old;
+        old.swap(slots_);
+        slots_.resize(capacity);
+        for (unsigned int j = 0; j < old.size(); ++j)
+        {
+            if (old[j].used)
+                slots_[probe(old[j].key)] = old[j];
+        }
+    }
+
+    // capacity is always a power of two
+    std::vector<Slot> slots_;
+    unsigned int size_;
+};
+
+typedef GtpHashTable<ConnectionInfo> LabelTable;
 //===================================================================
 
 //=================== Traffic filters management ====================
@@ -120,6 +120,14 @@ void D2DModeSelectionBase::doModeSwitchAtHandover(MacNodeId nodeId, bool handove
 
 void D2DModeSelectionBase::sendModeSwitchNotifications()
 {
+    if (switchList_.empty())
+        return;
+
+    // all the notifications of this selection instance are sent by the MAC of this eNB
+    LteMacEnbD2D* macD2D = check_and_cast<LteMacEnbD2D*>(mac_);
+
+    EV << NOW << " D2DModeSelectionBase::sendModeSwitchNotifications - " << switchList_.size() << " flows to be switched" << endl;
+
     SwitchList::iterator it = switchList_.begin();
     for (; it != switchList_.end(); ++it)
     {
@@ -128,6 +136,6 @@ void D2DModeSelectionBase::sendModeSwitchNotifications()
         LteD2DMode oldMode = it->oldMode;
         LteD2DMode newMode = it->newMode;
 
-        check_and_cast<LteMacEnbD2D*>(mac_)->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
+        macD2D->sendModeSwitchNotification(srcId, dstId, oldMode, newMode);
     }
 }
@@ -19,46 +19,109 @@ void D2DModeSelectionBestCqi::initialize(int stage)
     D2DModeSelectionBase::initialize(stage);
 }
 
+void D2DModeSelectionBestCqi::updatePeerings()
+{
+    // pairs are never removed from the peering map, hence its size changes only if new pairs have been added
+    unsigned int numPairs = 0;
+    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = peeringModeMap_->begin();
+    for (; it != peeringModeMap_->end(); ++it)
+        numPairs += it->second.size();
+
+    if (numPairs == numPairs_)
+        return;
+
+    EV << NOW << " D2DModeSelectionBestCqi::updatePeerings - " << numPairs << " D2D-capable flows (were " << numPairs_ << ")" << endl;
+
+    // the D2D CQI of a UE depends on its peers, thus all the transmitters must be evaluated again
+    transmitters_.clear();
+    peerings_.clear();
+    peerings_.reserve(numPairs);
+    for (it = peeringModeMap_->begin(); it != peeringModeMap_->end(); ++it)
+    {
+        if (it->second.empty())
+            continue;
+
+        Transmitter tx;
+        tx.srcId = it->first;
+        tx.firstPeering = peerings_.size();
+        tx.numPeerings = it->second.size();
+        tx.epoch = 0;
+        tx.evaluated = false;
+        tx.bestMode = IM;
+        transmitters_.push_back(tx);
+
+        std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
+        for (; jt != it->second.end(); ++jt)
+        {
+            Peering peering;
+            peering.dstId = jt->first;
+            peering.mode = &(jt->second);
+            peerings_.push_back(peering);
+        }
+    }
+    numPairs_ = numPairs;
+}
+
 void D2DModeSelectionBestCqi::doModeSelection()
 {
     EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - Running Mode Selection algorithm..." << endl;
 
     switchList_.clear();
-    std::map<MacNodeId, std::map<MacNodeId, LteD2DMode> >::iterator it = peeringModeMap_->begin();
-    for (; it != peeringModeMap_->end(); ++it)
+    updatePeerings();
+
+    LteAmc* amc = mac_->getAmc();
+    MacCellId cellId = mac_->getMacCellId();
+    std::vector<Transmitter>::iterator it = transmitters_.begin();
+    for (; it != transmitters_.end(); ++it)
     {
-        MacNodeId srcId = it->first;
+        MacNodeId srcId = it->srcId;
 
         // consider only UEs within this cell
-        if (binder_->getNextHop(srcId) != mac_->getMacCellId())
+        if (binder_->getNextHop(srcId) != cellId)
             continue;
 
-        std::map<MacNodeId, LteD2DMode>::iterator jt = it->second.begin();
-        for (; jt != it->second.end(); ++jt)
+        // skip UEs that are performing handover
+        if (binder_->hasUeHandoverTriggered(srcId))
+            continue;
+
+        std::vector<Peering>::iterator jt = peerings_.begin() + it->firstPeering;
+        std::vector<Peering>::iterator et = jt + it->numPeerings;
+        for (; jt != et; ++jt)
         {
-            MacNodeId dstId = jt->first;   // since the D2D CQI is the same for all D2D connections,
+            MacNodeId dstId = jt->dstId;   // since the D2D CQI is the same for all D2D connections,
                                             // the mode will be the same for all destinations
 
             // consider only UEs within this cell
-            if (binder_->getNextHop(dstId) != mac_->getMacCellId())
+            if (binder_->getNextHop(dstId) != cellId)
                 continue;
 
             // skip UEs that are performing handover
-            if (binder_->hasUeHandoverTriggered(dstId) || binder_->hasUeHandoverTriggered(srcId))
+            if (binder_->hasUeHandoverTriggered(dstId))
                 continue;
 
-            LteD2DMode oldMode = jt->second;
-
-            // Compute the achievable bits on a single RB for UL direction
-            // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
-            // is the minimum CQI over all RBs)
-            unsigned int bitsUl = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
-            unsigned int bitsD2D = mac_->getAmc()->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
-
-            EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
+            // compute the best mode only if the CQIs of the transmitter may have changed
+            unsigned long epoch = amc->getFeedbackEpoch(srcId);
+            if (!it->evaluated || it->epoch != epoch)
+            {
+                // Compute the achievable bits on a single RB for UL direction
+                // Note that this operation takes into account the CQI returned by the AMC Pilot (by default, it
+                // is the minimum CQI over all RBs)
+                // Note also that the per-codeword version of computeBitsOnNRbs() does not emit the measuredItbs
+                // signal, hence skipping it for cached transmitters does not change the recorded statistics
+                unsigned int bitsUl = amc->computeBitsOnNRbs(srcId, 0, 0, 1, UL);
+                unsigned int bitsD2D = amc->computeBitsOnNRbs(srcId, 0, 0, 1, D2D);
+
+                EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - UE " << srcId << " bitsUl[" << bitsUl << "] bitsD2D[" << bitsD2D << "]" << endl;
+
+                // compare the bits in the two modes and select the best one
+                it->bestMode = (bitsUl > bitsD2D) ? IM : DM;
+                it->epoch = epoch;
+                it->evaluated = true;
+            }
 
-            // compare the bits in the two modes and select the best one
-            LteD2DMode newMode = (bitsUl > bitsD2D) ? IM : DM;
+            // the current mode may have been changed elsewhere (e.g. at handover), hence it is always checked
+            LteD2DMode oldMode = *(jt->mode);
+            LteD2DMode newMode = it->bestMode;
 
             if (newMode != oldMode)
             {
@@ -71,7 +134,7 @@ void D2DModeSelectionBestCqi::doModeSelection()
                 switchList_.push_back(info);
 
                 // update peering map
-                jt->second = newMode;
+                *(jt->mode) = newMode;
 
                 EV << NOW << " D2DModeSelectionBestCqi::doModeSelection - Flow: " << srcId << " --> " << dstId << " [" << d2dModeToA(newMode) << "]" << endl;
             }
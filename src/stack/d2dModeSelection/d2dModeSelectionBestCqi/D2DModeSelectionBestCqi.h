@@ -17,16 +17,54 @@
 //
 // For each D2D-capable flow, select the mode having the best CQI
 //
+// Since the CQIs only depend on the transmitter, the best mode is computed once per transmitter,
+// and only when its CQIs may have changed since the previous selection (according to the
+// feedback epochs of the AMC module). Peering relationships are copied from the binder's map
+// into dense arrays, which are rebuilt only when new relationships are added.
+// The selected modes and the recorded statistics are the same as when evaluating every flow
+// at every period
+//
 class SIMULTE_API D2DModeSelectionBestCqi : public D2DModeSelectionBase
 {
 
 protected:
 
+    // D2D-capable flow. The mode points to the entry of the binder's peering map
+    // (entries of std::map are not moved nor removed)
+    struct Peering
+    {
+        MacNodeId dstId;
+        LteD2DMode* mode;
+    };
+
+    // transmitter of D2D-capable flows, whose peerings are stored in
+    // peerings_[firstPeering, firstPeering + numPeerings)
+    struct Transmitter
+    {
+        MacNodeId srcId;
+        unsigned int firstPeering;
+        unsigned int numPeerings;
+
+        // feedback epoch the best mode has been computed with (valid only if evaluated is true)
+        unsigned long epoch;
+        bool evaluated;
+        LteD2DMode bestMode;
+    };
+
+    std::vector<Transmitter> transmitters_;
+    std::vector<Peering> peerings_;
+
+    // number of pairs in the peering map when the arrays have been built
+    unsigned int numPairs_;
+
+    // rebuild the arrays if pairs have been added to the peering map
+    void updatePeerings();
+
     // run the mode selection algorithm
     virtual void doModeSelection();
 
 public:
-    D2DModeSelectionBestCqi() {}
+    D2DModeSelectionBestCqi() { numPairs_ = 0; }
     virtual ~D2DModeSelectionBestCqi() {}
 
     virtual void initialize(int stage);
@@ -16,6 +16,17 @@ Define_Module(LteHandoverManager);
 using namespace inet;
 using namespace omnetpp;
 
+LteHandoverManager::~LteHandoverManager()
+{
+    std::map<MacNodeId, ForwardingBatch>::iterator it;
+    for (it = forwardingBatches_.begin(); it != forwardingBatches_.end(); ++it)
+    {
+        for (unsigned int i = 0; i < it->second.datagrams.size(); i++)
+            delete it->second.datagrams[i];
+        cancelAndDelete(it->second.timer);
+    }
+}
+
 void LteHandoverManager::initialize()
 {
     // get the node id
@@ -30,6 +41,12 @@ void LteHandoverManager::initialize()
 
     losslessHandover_ = par("losslessHandover").boolValue();
 
+    forwardingBatchWindow_ = par("forwardingBatchWindow");
+    forwardingBatchMaxSize_ = par("forwardingBatchMaxSize");
+
+    forwardingBatchSize_ = registerSignal("handoverForwardingBatchSize");
+    forwardingDelay_ = registerSignal("handoverForwardingDelay");
+
     // register to the X2 Manager
     auto x2Packet = new Packet("X2HandoverControlMsg");
     auto initMsg = makeShared<X2HandoverControlMsg>();
@@ -42,6 +59,13 @@ void LteHandoverManager::initialize()
 
 void LteHandoverManager::handleMessage(cMessage *msg)
 {
+    if (msg->isSelfMessage())
+    {
+        // the batching window of a pending batch has expired
+        sendForwardingBatch(*static_cast<ForwardingBatch*>(msg->getContextPointer()));
+        return;
+    }
+
     cPacket* pkt = check_and_cast<cPacket*>(msg);
     cGate* incoming = pkt->getArrivalGate();
     if (incoming == x2Manager_[IN_GATE])
@@ -65,7 +89,33 @@ void LteHandoverManager::handleX2Message(cPacket* pkt)
 
     if (x2msg->getType() == X2_HANDOVER_DATA_MSG)
     {
-        receiveDataFromSourceEnb(datagram, sourceId);
+        // check whether the message carries several datagrams
+        const X2HandoverDataBatchIE* batchIe = nullptr;
+        X2InformationElementsList ieList = x2msg->getIeList();
+        for (X2InformationElementsList::iterator it = ieList.begin(); it != ieList.end(); ++it)
+        {
+            if ((*it)->getType() == X2_HANDOVER_DATA_BATCH_IE)
+                batchIe = check_and_cast<const X2HandoverDataBatchIE*>(*it);
+        }
+
+        if (batchIe == nullptr)
+        {
+            receiveDataFromSourceEnb(datagram, sourceId);
+        }
+        else
+        {
+            // unpack the datagrams, in the same order they were forwarded
+            b offset = b(0);
+            for (unsigned int i = 0; i < batchIe->getNumDatagrams(); i++)
+            {
+                B length = B(batchIe->getDatagramLength(i));
+                const char* name = batchIe->getDatagramName(i);
+                Packet* pkt = new Packet((*name != '\0') ? name : "X2HandoverData", datagram->peekDataAt(offset, length));
+                offset += length;
+                receiveDataFromSourceEnb(pkt, sourceId);
+            }
+            delete datagram;
+        }
     }
     else   // X2_HANDOVER_CONTROL_MSG
     {
@@ -115,9 +165,18 @@ void LteHandoverManager::receiveHandoverCommand(MacNodeId ueId, MacNodeId enb, b
 
     // send command to IP2lte/PDCP
     if (startHo)
+    {
         ip2lte_->triggerHandoverTarget(ueId, enb);
+    }
     else
+    {
+        // do not hold the datagrams still pending for the target until the batching window expires
+        std::map<MacNodeId, ForwardingBatch>::iterator it = forwardingBatches_.find(enb);
+        if (it != forwardingBatches_.end())
+            sendForwardingBatch(it->second);
+
         ip2lte_->signalHandoverCompleteSource(ueId, enb);
+    }
 }
 
 
@@ -126,6 +185,85 @@ void LteHandoverManager::forwardDataToTargetEnb(Packet* datagram, MacNodeId targ
     Enter_Method("forwardDataToTargetEnb");
     take(datagram);
 
+    if (forwardingBatchWindow_ == 0)
+    {
+        emit(forwardingBatchSize_, (long)1);
+        emit(forwardingDelay_, SIMTIME_ZERO);
+
+        EV<<NOW<<" LteHandoverManager::forwardDataToTargetEnb - Send IP datagram to eNB " << targetEnb << endl;
+        sendDataMsg(datagram, targetEnb, nullptr);
+        return;
+    }
+
+    std::map<MacNodeId, ForwardingBatch>::iterator it = forwardingBatches_.find(targetEnb);
+    if (it == forwardingBatches_.end())
+    {
+        ForwardingBatch newBatch;
+        newBatch.targetEnb = targetEnb;
+        newBatch.length = 0;
+        newBatch.timer = nullptr;
+        it = forwardingBatches_.insert(std::make_pair(targetEnb, newBatch)).first;
+        it->second.timer = new cMessage("forwardingBatchTimer");
+        it->second.timer->setContextPointer(&it->second);
+    }
+    ForwardingBatch& batch = it->second;
+
+    // send the pending datagrams first, if this one does not fit in the batch
+    int64_t length = B(datagram->getDataLength()).get();
+    if (!batch.datagrams.empty() && batch.length + length > forwardingBatchMaxSize_)
+        sendForwardingBatch(batch);
+
+    // the batching window starts with the first datagram of the batch
+    if (batch.datagrams.empty())
+        scheduleAt(NOW + forwardingBatchWindow_, batch.timer);
+
+    batch.datagrams.push_back(datagram);
+    batch.arrivalTimes.push_back(NOW);
+    batch.length += length;
+
+    EV<<NOW<<" LteHandoverManager::forwardDataToTargetEnb - Added IP datagram to the batch for eNB " << targetEnb
+      << " [" << batch.datagrams.size() << " datagrams]" << endl;
+}
+
+void LteHandoverManager::sendForwardingBatch(ForwardingBatch& batch)
+{
+    if (batch.timer->isScheduled())
+        cancelEvent(batch.timer);
+    if (batch.datagrams.empty())
+        return;
+
+    EV<<NOW<<" LteHandoverManager::sendForwardingBatch - Send " << batch.datagrams.size() << " IP datagrams to eNB " << batch.targetEnb << endl;
+
+    emit(forwardingBatchSize_, (long)batch.datagrams.size());
+    for (unsigned int i = 0; i < batch.arrivalTimes.size(); i++)
+        emit(forwardingDelay_, NOW - batch.arrivalTimes[i]);
+
+    if (batch.datagrams.size() == 1)
+    {
+        sendDataMsg(batch.datagrams.front(), batch.targetEnb, nullptr);
+    }
+    else
+    {
+        // concatenate the datagrams, whose lengths are listed in the batch IE
+        X2HandoverDataBatchIE* batchIe = new X2HandoverDataBatchIE();
+        Packet* pkt = new Packet("X2HandoverDataMsg");
+        for (unsigned int i = 0; i < batch.datagrams.size(); i++)
+        {
+            Packet* datagram = batch.datagrams[i];
+            batchIe->addDatagram(B(datagram->getDataLength()).get(), datagram->getName());
+            pkt->insertAtBack(datagram->peekData());
+            delete datagram;
+        }
+        sendDataMsg(pkt, batch.targetEnb, batchIe);
+    }
+
+    batch.datagrams.clear();
+    batch.arrivalTimes.clear();
+    batch.length = 0;
+}
+
+void LteHandoverManager::sendDataMsg(Packet* datagram, MacNodeId targetEnb, X2HandoverDataBatchIE* batchIe)
+{
     // build control info
     auto ctrlInfo = datagram->addTagIfAbsent<X2ControlInfoTag>();
     ctrlInfo->setSourceId(nodeId_);
@@ -135,11 +273,11 @@ void LteHandoverManager::forwardDataToTargetEnb(Packet* datagram, MacNodeId targ
 
     // build X2 Handover Msg
     auto hoMsg = makeShared<X2HandoverDataMsg>();
+    if (batchIe != nullptr)
+        hoMsg->pushIe(batchIe);
     datagram->insertAtFront(hoMsg);
     datagram->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::x2ap);
 
-    EV<<NOW<<" LteHandoverManager::forwardDataToTargetEnb - Send IP datagram to eNB " << targetEnb << endl;
-
     // send to X2 Manager
     send(datagram,x2Manager_[OUT_GATE]);
 }
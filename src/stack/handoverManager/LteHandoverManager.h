@@ -14,6 +14,7 @@
 #include "x2/packet/X2ControlInfo_m.h"
 #include "stack/handoverManager/X2HandoverControlMsg.h"
 #include "stack/handoverManager/X2HandoverDataMsg.h"
+#include "stack/handoverManager/X2HandoverDataBatchIE.h"
 #include "corenetwork/lteip/IP2lte.h"
 
 class IP2lte;
@@ -38,11 +39,41 @@ class SIMULTE_API LteHandoverManager : public omnetpp::cSimpleModule
     // flag for seamless/lossless handover
     bool losslessHandover_;
 
+    /*
+     * Datagrams forwarded to the same target eNB within the batching window are carried
+     * by a single X2 data message, up to the maximum batch size.
+     * Batching is disabled if the window is zero
+     */
+    omnetpp::simtime_t forwardingBatchWindow_;
+    int64_t forwardingBatchMaxSize_;   // in bytes
+
+    struct ForwardingBatch
+    {
+        MacNodeId targetEnb;
+        std::vector<inet::Packet*> datagrams;
+        std::vector<omnetpp::simtime_t> arrivalTimes;
+        int64_t length;                // in bytes
+        omnetpp::cMessage* timer;
+    };
+
+    // pending batches, one for each target eNB
+    std::map<MacNodeId, ForwardingBatch> forwardingBatches_;
+
+    // statistics
+    omnetpp::simsignal_t forwardingBatchSize_;
+    omnetpp::simsignal_t forwardingDelay_;
+
     void handleX2Message(omnetpp::cPacket* pkt);
 
+    // send the datagrams of a pending batch within a single X2 data message
+    void sendForwardingBatch(ForwardingBatch& batch);
+
+    // encapsulate the given packet in a X2 data message and send it to the X2 Manager
+    void sendDataMsg(inet::Packet* pkt, MacNodeId targetEnb, X2HandoverDataBatchIE* batchIe);
+
   public:
     LteHandoverManager() {}
-    virtual ~LteHandoverManager() {}
+    virtual ~LteHandoverManager();
 
     virtual void initialize() override;
     virtual void handleMessage(omnetpp::cMessage *msg) override;
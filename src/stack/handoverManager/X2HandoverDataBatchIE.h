@@ -0,0 +1,72 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_X2HANDOVERDATABATCHIE_H_
+#define _LTE_X2HANDOVERDATABATCHIE_H_
+
+#include <vector>
+#include <string>
+#include "x2/packet/X2InformationElement.h"
+
+//
+// X2HandoverDataBatchIE
+//
+// Describes the IP datagrams carried, one after the other, by a X2 handover data message.
+// Only the lengths are part of the serialized IE: the names of the datagrams are
+// simulation metadata, used to rebuild the packets at the target eNB
+//
+class SIMULTE_API X2HandoverDataBatchIE : public X2InformationElement
+{
+protected:
+
+    std::vector<uint32_t> datagramLengths_;    // in bytes
+    std::vector<std::string> datagramNames_;
+
+public:
+  X2HandoverDataBatchIE()
+  {
+      type_ = X2_HANDOVER_DATA_BATCH_IE;
+      length_ = sizeof(uint16_t);
+  }
+  X2HandoverDataBatchIE(const X2HandoverDataBatchIE& other) :
+      X2InformationElement()
+  {
+      operator=(other);
+  }
+
+  X2HandoverDataBatchIE& operator=(const X2HandoverDataBatchIE& other)
+  {
+      if (&other == this)
+          return *this;
+      X2InformationElement::operator=(other);
+      datagramLengths_ = other.datagramLengths_;
+      datagramNames_ = other.datagramNames_;
+      return *this;
+  }
+  virtual X2HandoverDataBatchIE *dup() const
+  {
+      return new X2HandoverDataBatchIE(*this);
+  }
+  virtual ~X2HandoverDataBatchIE() {}
+
+  // add a datagram (to be done before pushing the IE into the message)
+  void addDatagram(uint32_t length, const char* name)
+  {
+      datagramLengths_.push_back(length);
+      datagramNames_.push_back(name);
+      length_ += sizeof(uint32_t);
+  }
+
+  // getter methods
+  unsigned int getNumDatagrams() const { return datagramLengths_.size(); }
+  uint32_t getDatagramLength(unsigned int i) const { return datagramLengths_.at(i); }
+  const char* getDatagramName(unsigned int i) const { return datagramNames_.at(i).c_str(); }
+};
+
+#endif
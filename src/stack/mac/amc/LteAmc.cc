@@ -204,6 +204,7 @@ LteAmc::LteAmc(LteMacEnb *mac, LteBinder *binder, LteCellInfo *cellInfo, int num
 {
     mac_ = mac;
     binder_ = binder;
+    structureEpoch_ = 0;
     cellInfo_ = cellInfo;
     numAntennas_ = numAntennas;
     initialize();
@@ -406,6 +407,8 @@ void LteAmc::pushFeedback(MacNodeId id, Direction dir, LteFeedback fb)
     EV << "ID: " << id << endl;
     EV << "index: " << index << endl;
     (*history)[antenna].at(index).at(txMode).put(fb);
+    if (dir == UL)
+        feedbackEpoch_[id]++;
 
     // DEBUG
 //    printFbhb(dir);
@@ -444,8 +447,12 @@ void LteAmc::pushFeedbackD2D(MacNodeId id, LteFeedback fb, MacNodeId peerId)
             newHist[antenna].push_back(std::vector<LteSummaryBuffer>(UL_NUM_TXMODE, LteSummaryBuffer(fbhbCapacityD2D_, MAXCW, numBands_, lb_, ub_)));
         }
         (*history)[peerId] = newHist;
+
+        // the peer selected by getFeedbackD2D() may change
+        structureEpoch_++;
     }
     (*history)[peerId][antenna].at(index).at(txMode).put(fb);
+    feedbackEpoch_[id]++;
 
     // DEBUG
     EV << "PeerId: " << peerId << ", Antenna: " << dasToA(antenna) << ", TxMode: " << txMode << ", Index: " << index << endl;
@@ -876,6 +883,7 @@ unsigned int LteAmc::computeBitsOnNRbs_MB(MacNodeId id, Band b,  unsigned int bl
 bool LteAmc::setPilotUsableBands(MacNodeId id , std::vector<unsigned short>  usableBands)
 {
     pilot_->setUsableBands(id,usableBands);
+    feedbackEpoch_[id]++;
     return true;
 }
 
@@ -1279,6 +1287,9 @@ void LteAmc::detachUser(MacNodeId nodeId, Direction dir)
     EV << "##################################" << endl;
     EV << "# LteAmc::detachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
     EV << "##################################" << endl;
+
+    // node indices are going to change
+    structureEpoch_++;
     try
     {
         ConnectedUesMap *connectedUe;
@@ -1359,6 +1370,9 @@ void LteAmc::attachUser(MacNodeId nodeId, Direction dir)
     EV << "# LteAmc::attachUser. Id: " << nodeId << ", direction: " << dirToA(dir) << endl;
     EV << "##################################" << endl;
 
+    // node indices are going to change
+    structureEpoch_++;
+
     ConnectedUesMap *connectedUe;
     std::map<MacNodeId, unsigned int> *nodeIndexMap;
     std::vector<MacNodeId> *revIndexVec;
@@ -89,6 +89,11 @@ class SIMULTE_API LteAmc
     LteMuMimoMatrix muMimoDlMatrix_;
     LteMuMimoMatrix muMimoUlMatrix_;
     LteMuMimoMatrix muMimoD2DMatrix_;
+
+    // number of UL and D2D feedback reports received from each UE
+    std::map<MacNodeId, unsigned long> feedbackEpoch_;
+    // incremented when the set of users or of D2D peers changes
+    unsigned long structureEpoch_;
     public:
     LteAmc(LteMacEnb *mac, LteBinder *binder, LteCellInfo *cellInfo, int numAntennas);
     void initialize();
@@ -110,6 +115,15 @@ class SIMULTE_API LteAmc
     LteSummaryFeedback getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir);
     LteSummaryFeedback getFeedbackD2D(MacNodeId id, Remote antenna, TxMode txMode, MacNodeId peerId);
 
+    // returns a counter that is incremented whenever the UL or D2D tx parameters computed for the
+    // given UE may have changed (new feedback from it, users attached/detached, new D2D peers).
+    // Modules caching values derived from such parameters can re-compute them only when it changes
+    unsigned long getFeedbackEpoch(MacNodeId id) const
+    {
+        std::map<MacNodeId, unsigned long>::const_iterator it = feedbackEpoch_.find(id);
+        return structureEpoch_ + ((it != feedbackEpoch_.end()) ? it->second : 0);
+    }
+
     //used when is necessary to know if the requested feedback exists or not
     // LteSummaryFeedback getFeedback(MacNodeId id, Remote antenna, TxMode txMode, const Direction dir,bool& valid);
 
@@ -133,6 +147,7 @@ class SIMULTE_API LteAmc
     void cleanAmcStructures(Direction dir, ActiveSet aUser);
     unsigned int computeReqRbs(MacNodeId id, Band b, Codeword cw, unsigned int bytes, const Direction dir);
     unsigned int computeBitsOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir);
+    // unlike the version above, it does not emit the measuredItbs signal of the MAC
     unsigned int computeBitsOnNRbs(MacNodeId id, Band b, Codeword cw, unsigned int blocks, const Direction dir);
     unsigned int computeBytesOnNRbs(MacNodeId id, Band b, unsigned int blocks, const Direction dir);
     unsigned int computeBytesOnNRbs(MacNodeId id, Band b, Codeword cw, unsigned int blocks, const Direction dir);
@@ -26,7 +26,6 @@ LteMacBuffer::LteMacBuffer(const LteMacQueue& queue)
 
 LteMacBuffer::~LteMacBuffer()
 {
-    Queue_.clear();
 }
 
 LteMacBuffer& LteMacBuffer::operator=(const LteMacBuffer& queue)
@@ -46,14 +45,14 @@ void LteMacBuffer::pushBack(PacketInfo pkt)
 {
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_back(pkt);
+    Queue_.pushBack(pkt);
 }
 
 void LteMacBuffer::pushFront(PacketInfo pkt)
 {
     queueLength_++;
     queueOccupancy_ += pkt.first;
-    Queue_.push_front(pkt);
+    Queue_.pushFront(pkt);
 }
 
 PacketInfo LteMacBuffer::popFront()
@@ -61,8 +60,7 @@ PacketInfo LteMacBuffer::popFront()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.front();
-    Queue_.pop_front();
+    PacketInfo pkt = Queue_.popFront();
     processed_++;
     queueLength_--;
     queueOccupancy_ -= pkt.first;
@@ -74,8 +72,7 @@ PacketInfo LteMacBuffer::popBack()
     if (queueLength_ <= 0)
         throw cRuntimeError("Packet queue empty");
 
-    PacketInfo pkt = Queue_.back();
-    Queue_.pop_back();
+    PacketInfo pkt = Queue_.popBack();
     queueLength_--;
     queueOccupancy_ -= pkt.first;
     return pkt;
@@ -112,7 +109,7 @@ unsigned int LteMacBuffer::getProcessed() const
     return processed_;
 }
 
-const std::list<PacketInfo>*
+const RingBuffer<PacketInfo>*
 LteMacBuffer::getPacketlist() const
 {
     return &Queue_;
@@ -12,12 +12,16 @@
 
 #include <omnetpp.h>
 #include "common/LteCommon.h"
+#include "common/RingBuffer.h"
 
 class LteMacQueue;
 
 /**
  * @class LteMacBuffer
  * @brief  Buffers for MAC packets
+ *
+ * Packet descriptors are stored in a contiguous ring buffer,
+ * so that operations at both ends of the queue are O(1)
  */
 class SIMULTE_API LteMacBuffer
 {
@@ -141,7 +145,7 @@ class SIMULTE_API LteMacBuffer
     /**
      * Get direct (readonly) access to pdu list
      */
-    const std::list<PacketInfo>* getPacketlist() const;
+    const RingBuffer<PacketInfo>* getPacketlist() const;
 
     friend std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue);
 
@@ -155,8 +159,8 @@ class SIMULTE_API LteMacBuffer
     /// Number of queued  packets
     int queueLength_;
 
-    /// List of  packets
-    std::list<PacketInfo> Queue_;
+    /// Ring buffer of  packets
+    RingBuffer<PacketInfo> Queue_;
 };
 
 #endif
@@ -15,21 +15,51 @@ using namespace omnetpp;
 using namespace inet;
 
 LteMacQueue::LteMacQueue(int queueSize) :
-    cPacketQueue("LteMacQueue")
+    cOwnedObject("LteMacQueue")
 {
     queueSize_ = queueSize;
+    byteLength_ = 0;
     lastUnenqueueableMainSno = UINT_MAX;
 }
 
-LteMacQueue::LteMacQueue(const LteMacQueue& queue)
+LteMacQueue::LteMacQueue(const LteMacQueue& queue) :
+    cOwnedObject(queue)
 {
+    byteLength_ = 0;
     operator=(queue);
 }
 
+LteMacQueue::~LteMacQueue()
+{
+    while (!packets_.empty())
+    {
+        cPacket* pkt = packets_.popFront();
+        drop(pkt);
+        delete pkt;
+    }
+}
+
 LteMacQueue& LteMacQueue::operator=(const LteMacQueue& queue)
 {
-    cPacketQueue::operator=(queue);
+    if (this == &queue)
+        return *this;
+
+    cOwnedObject::operator=(queue);
+    while (!packets_.empty())
+    {
+        cPacket* pkt = packets_.popFront();
+        drop(pkt);
+        delete pkt;
+    }
+    for (unsigned int i = 0; i < queue.packets_.size(); ++i)
+    {
+        cPacket* pkt = queue.packets_.at(i)->dup();
+        take(pkt);
+        packets_.pushBack(pkt);
+    }
+    byteLength_ = queue.byteLength_;
     queueSize_ = queue.queueSize_;
+    lastUnenqueueableMainSno = queue.lastUnenqueueableMainSno;
     return *this;
 }
 
@@ -45,7 +75,9 @@ bool LteMacQueue::pushBack(cPacket *pkt)
     if (!isEnqueueablePacket(pktAux))
          return false; // packet queue full or we have discarded fragments for this main packet
 
-    cPacketQueue::insert(pkt);
+    take(pkt);
+    packets_.pushBack(pkt);
+    byteLength_ += pkt->getByteLength();
     return true;
 }
 
@@ -55,28 +87,47 @@ bool LteMacQueue::pushFront(cPacket *pkt)
     if (!isEnqueueablePacket(pktAux))
         return false; // packet queue full or we have discarded fragments for this main packet
 
-    cPacketQueue::insertBefore(cPacketQueue::front(), pkt);
+    take(pkt);
+    packets_.pushFront(pkt);
+    byteLength_ += pkt->getByteLength();
     return true;
 }
 
 cPacket* LteMacQueue::popFront()
 {
-    return getQueueLength() > 0 ? cPacketQueue::pop() : nullptr;
+    if (packets_.empty())
+        return nullptr;
+
+    cPacket* pkt = packets_.popFront();
+    byteLength_ -= pkt->getByteLength();
+    drop(pkt);
+    return pkt;
 }
 
 cPacket* LteMacQueue::popBack()
 {
-    return getQueueLength() > 0 ? cPacketQueue::remove(cPacketQueue::back()) : nullptr;
+    if (packets_.empty())
+        return nullptr;
+
+    cPacket* pkt = packets_.popBack();
+    byteLength_ -= pkt->getByteLength();
+    drop(pkt);
+    return pkt;
+}
+
+cPacket* LteMacQueue::front() const
+{
+    return packets_.empty() ? nullptr : packets_.front();
 }
 
 simtime_t LteMacQueue::getHolTimestamp() const
 {
-    return getQueueLength() > 0 ? cPacketQueue::front()->getTimestamp() : 0;
+    return packets_.empty() ? 0 : packets_.front()->getTimestamp();
 }
 
 int64_t LteMacQueue::getQueueOccupancy() const
 {
-    return cPacketQueue::getByteLength();
+    return byteLength_;
 }
 
 int64_t LteMacQueue::getQueueSize() const
@@ -122,7 +173,13 @@ bool LteMacQueue::isEnqueueablePacket(Packet* pkt){
 
 int LteMacQueue::getQueueLength() const
 {
-    return cPacketQueue::getLength();
+    return packets_.size();
+}
+
+void LteMacQueue::forEachChild(cVisitor *v)
+{
+    for (unsigned int i = 0; i < packets_.size(); ++i)
+        v->visit(packets_.at(i));
 }
 
 std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue)
@@ -13,6 +13,7 @@
 #include <omnetpp.h>
 #include "inet/common/packet/Packet.h"
 #include "common/LteCommon.h"
+#include "common/RingBuffer.h"
 #include "stack/rlc/packet/LteRlcPdu_m.h"
 
 /**
@@ -30,20 +31,22 @@
  * dropped if stored packets exceeds the queue size
  * A size equal to 0 means that the size is infinite.
  *
+ * Packets are stored in a contiguous ring buffer, hence insertion
+ * and extraction at both ends of the queue are O(1). The queue owns
+ * the packets it contains.
+ *
  */
-class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
+class SIMULTE_API LteMacQueue : public omnetpp::cOwnedObject
 {
   public:
 
     /**
-     * Constructor creates a new cPacketQueue
+     * Constructor creates a new empty queue
      * with configurable maximum size
      */
     LteMacQueue(int queueSize);
 
-    virtual ~LteMacQueue()
-    {
-    }
+    virtual ~LteMacQueue();
 
     /**
      * Copy Constructors
@@ -92,6 +95,15 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
      */
     omnetpp::cPacket* popBack();
 
+    /**
+     * front() returns the packet in front of the queue
+     * without performing actual extraction.
+     *
+     * @return NULL if queue is empty,
+     *            pkt on successful operation
+     */
+    omnetpp::cPacket* front() const;
+
     /**
      * getQueueOccupancy() returns the occupancy
      * of the queue (in bytes)
@@ -116,6 +128,18 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
      */
     int getQueueLength() const;
 
+    /**
+     * isEmpty()
+     * @return TRUE if the queue is empty
+     */
+    bool isEmpty() const { return packets_.empty(); }
+
+    /**
+     * getByteLength() returns the occupancy
+     * of the queue (in bytes)
+     */
+    int64_t getByteLength() const { return byteLength_; }
+
     /**
      * getHolTimestamp() returns the timestamp
      * of the Head Of Line (front) packet of the queue
@@ -124,6 +148,8 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
      */
     omnetpp::simtime_t getHolTimestamp() const;
 
+    virtual void forEachChild(omnetpp::cVisitor *v) override;
+
     friend std::ostream &operator << (std::ostream &stream, const LteMacQueue* queue);
 
   protected:
@@ -142,6 +168,12 @@ class SIMULTE_API LteMacQueue : public omnetpp::cPacketQueue
   private:
     /// Size of queue
     int queueSize_;
+
+    /// Occupancy of the queue (in bytes)
+    int64_t byteLength_;
+
+    /// Ring buffer of the queued packets
+    RingBuffer<omnetpp::cPacket*> packets_;
 };
 
 #endif
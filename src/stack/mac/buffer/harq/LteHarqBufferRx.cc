@@ -28,10 +28,12 @@ LteHarqBufferRx::LteHarqBufferRx(unsigned int num, LteMacBase *owner,
     processes_.resize(numHarqProcesses_);
     totalRcvdBytes_ = 0;
     isMulticast_ = false;
+    corruptedProcMask_ = 0;
 
     for (unsigned int i = 0; i < numHarqProcesses_; i++)
     {
         processes_[i] = new LteHarqProcessRx(i, macOwner_);
+        processes_[i]->setBuffer(this);
     }
 
     /* Signals initialization: those are used to gather statistics */
@@ -187,8 +189,23 @@ RxBufferStatus LteHarqBufferRx::getBufferStatus()
     return bs;
 }
 
+void LteHarqBufferRx::updateCorruptedMask(unsigned char acid)
+{
+    unsigned int bit = 1u << acid;
+    if (macUe_ != nullptr && processes_[acid]->hasCorruptedUnits())
+        corruptedProcMask_ |= bit;
+    else
+        corruptedProcMask_ &= ~bit;
+
+    macOwner_->setHarqRxCorrupted(nodeId_, corruptedProcMask_ != 0);
+}
+
 LteHarqBufferRx::~LteHarqBufferRx()
 {
+    // this buffer is no longer active
+    if (macOwner_ != nullptr)
+        macOwner_->setHarqRxCorrupted(nodeId_, false);
+
     std::vector<LteHarqProcessRx *>::iterator it = processes_.begin();
     for (; it != processes_.end(); ++it)
         delete *it;
@@ -42,6 +42,9 @@ class SIMULTE_API LteHarqBufferRx
     /// processes vector
     std::vector<LteHarqProcessRx *> processes_;
 
+    /// Bitmask with one bit per acid, marking the processes having corrupted units
+    unsigned int corruptedProcMask_;
+
     /// flag for multicast flows
     bool isMulticast_;
 
@@ -123,6 +126,16 @@ class SIMULTE_API LteHarqBufferRx
         macUe_ = nullptr;
     }
 
+    /**
+     * Refreshes the bitmask entry of the given process, and notifies the
+     * owner MAC whether this buffer has corrupted units. Units of a node
+     * that left the simulation are never reported, since they cannot be
+     * retransmitted.
+     *
+     * @param acid the H-arq process
+     */
+    void updateCorruptedMask(unsigned char acid);
+
     virtual ~LteHarqBufferRx();
 
   protected:
@@ -23,6 +23,7 @@ LteHarqBufferTx::LteHarqBufferTx(unsigned int numProc, LteMacBase *owner, LteMac
     {
         (*processes_)[i] = new LteHarqProcessTx(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
     }
+    initProcessMasks();
 }
 
 UnitList LteHarqBufferTx::firstReadyForRtx()
@@ -31,16 +32,18 @@ UnitList LteHarqBufferTx::firstReadyForRtx()
     simtime_t oldestTxTime = NOW + 1;
     simtime_t currentTxTime = 0;
 
-    for (unsigned int i = 0; i < numProc_; i++)
+    // only visit the processes having ready units
+    unsigned int mask = readyProcMask_;
+    while (mask != 0)
     {
-        if ((*processes_)[i]->hasReadyUnits())
+        unsigned int i = __builtin_ctz(mask);
+        mask &= mask - 1;
+
+        currentTxTime = (*processes_)[i]->getOldestUnitTxTime();
+        if (currentTxTime < oldestTxTime)
         {
-            currentTxTime = (*processes_)[i]->getOldestUnitTxTime();
-            if (currentTxTime < oldestTxTime)
-            {
-                oldestTxTime = currentTxTime;
-                oldestProcessAcid = i;
-            }
+            oldestTxTime = currentTxTime;
+            oldestProcessAcid = i;
         }
     }
     UnitList ret;
@@ -108,7 +111,8 @@ void LteHarqBufferTx::markSelected(UnitList unitIds, unsigned char availableTbs)
         }
     }
 
-    selectedAcid_ = acid;
+    updateProcessMasks(acid);
+    setSelectedAcid(acid);
 
     // user tx params could have changed, modify them
     //    UserControlInfo *uInfo = check_and_cast<UserControlInfo *>(basePdu->getControlInfo());
@@ -134,9 +138,10 @@ void LteHarqBufferTx::insertPdu(unsigned char acid, Codeword cw, Packet *pkt)
     if (!(*processes_)[acid]->isUnitEmpty(cw))
         throw cRuntimeError("LteHarqBufferTx::insertPdu(): unit is not empty");
 
-    selectedAcid_ = acid;
+    setSelectedAcid(acid);
     numEmptyProc_--;
     (*processes_)[acid]->insertPdu(pkt, cw);
+    updateProcessMasks(acid);
 
     auto tag = pkt->getTag<UserControlInfo>();
     // debug output
@@ -154,14 +159,9 @@ LteHarqBufferTx::firstAvailable()
 
     if (selectedAcid_ == HARQ_NONE)
     {
-        for (unsigned int i = 0; i < numProc_; i++)
-        {
-            if ((*processes_)[i]->isEmpty())
-            {
-                acid = i;
-                break;
-            }
-        }
+        // lowest empty process, if any
+        if (emptyProcMask_ != 0)
+            acid = __builtin_ctz(emptyProcMask_);
     }
     else
     {
@@ -224,6 +224,7 @@ void LteHarqBufferTx::receiveHarqFeedback(Packet *pkt)
     bool reset = (*processes_)[acid]->pduFeedback(harqResult, cw);
     if (reset)
         numEmptyProc_++;
+    updateProcessMasks(acid);
 
     // debug output
     const char *ack = result ? "ACK" : "NACK";
@@ -255,7 +256,8 @@ void LteHarqBufferTx::sendSelectedDown()
         EV << "\t H-ARQ TX: pdu (id " << pduToSend->getId() << " ) extracted from process " << (int)selectedAcid_ << " "
         "codeword " << (int)*it << " for node with id " << cinfo->getDestId() << endl;
     }
-    selectedAcid_ = HARQ_NONE;
+    updateProcessMasks(selectedAcid_);
+    setSelectedAcid(HARQ_NONE);
 }
 
 void LteHarqBufferTx::dropProcess(unsigned char acid)
@@ -271,6 +273,7 @@ void LteHarqBufferTx::dropProcess(unsigned char acid)
     // if a process contains units in BUFFERED state, then all units of this
     // process are either empty or in BUFFERED state (ready).
     numEmptyProc_++;
+    updateProcessMasks(acid);
 }
 
 void LteHarqBufferTx::selfNack(unsigned char acid, Codeword cw)
@@ -285,14 +288,16 @@ void LteHarqBufferTx::selfNack(unsigned char acid, Codeword cw)
     }
     if (reset)
         numEmptyProc_++;
+    updateProcessMasks(acid);
 }
 
 void LteHarqBufferTx::forceDropProcess(unsigned char acid)
 {
     (*processes_)[acid]->forceDropProcess();
     if (acid == selectedAcid_)
-        selectedAcid_ = HARQ_NONE;
+        setSelectedAcid(HARQ_NONE);
     numEmptyProc_++;
+    updateProcessMasks(acid);
 }
 
 void LteHarqBufferTx::forceDropUnit(unsigned char acid, Codeword cw)
@@ -301,9 +306,10 @@ void LteHarqBufferTx::forceDropUnit(unsigned char acid, Codeword cw)
     if (reset)
     {
         if (acid == selectedAcid_)
-            selectedAcid_ = HARQ_NONE;
+            setSelectedAcid(HARQ_NONE);
         numEmptyProc_++;
     }
+    updateProcessMasks(acid);
 }
 
 BufferStatus LteHarqBufferTx::getBufferStatus()
@@ -341,6 +347,13 @@ LteHarqBufferTx::getSelectedProcess()
 
 LteHarqBufferTx::~LteHarqBufferTx()
 {
+    // this buffer is no longer active
+    if (macOwner_ != nullptr)
+    {
+        macOwner_->setHarqTxSelected(nodeId_, false);
+        macOwner_->setHarqTxReady(nodeId_, false);
+    }
+
     std::vector<LteHarqProcessTx *>::iterator it = processes_->begin();
     for (; it != processes_->end(); ++it)
         delete *it;
@@ -366,3 +379,37 @@ bool LteHarqBufferTx::isInUnitList(unsigned char acid, Codeword cw, UnitList uni
     }
     return false;
 }
+
+void LteHarqBufferTx::initProcessMasks()
+{
+    if (numProc_ > sizeof(unsigned int) * 8)
+        throw cRuntimeError("LteHarqBufferTx::initProcessMasks(): too many H-ARQ processes (%d)", numProc_);
+
+    readyProcMask_ = 0;
+    emptyProcMask_ = (numProc_ == sizeof(unsigned int) * 8) ? ~0u : ((1u << numProc_) - 1);
+}
+
+void LteHarqBufferTx::updateProcessMasks(unsigned char acid)
+{
+    if (acid == HARQ_NONE)
+        return;
+
+    unsigned int bit = 1u << acid;
+    if ((*processes_)[acid]->hasReadyUnits())
+        readyProcMask_ |= bit;
+    else
+        readyProcMask_ &= ~bit;
+
+    if ((*processes_)[acid]->isEmpty())
+        emptyProcMask_ |= bit;
+    else
+        emptyProcMask_ &= ~bit;
+
+    macOwner_->setHarqTxReady(nodeId_, readyProcMask_ != 0);
+}
+
+void LteHarqBufferTx::setSelectedAcid(unsigned char acid)
+{
+    selectedAcid_ = acid;
+    macOwner_->setHarqTxSelected(nodeId_, acid != HARQ_NONE);
+}
@@ -30,6 +30,14 @@ class SIMULTE_API LteHarqBufferTx
     unsigned char selectedAcid_; // @ insert, @ marksel, @ sendseldn
     MacNodeId nodeId_; // UE nodeId for which this buffer has been created
 
+    /*
+     * Bitmasks with one bit per acid, marking the processes having units ready
+     * for retransmission and the completely empty processes, respectively.
+     * They are refreshed whenever a process changes its status through this buffer
+     */
+    unsigned int readyProcMask_;
+    unsigned int emptyProcMask_;
+
   public:
 
     /*
@@ -188,6 +196,28 @@ class SIMULTE_API LteHarqBufferTx
      * @return true if the id is in the list, false otherwise.
      */
     bool isInUnitList(unsigned char acid, Codeword cw, UnitList unitIds);
+
+    /**
+     * Initializes the process bitmasks, with all processes empty.
+     * To be called by constructors once processes have been created.
+     */
+    void initProcessMasks();
+
+    /**
+     * Refreshes the bitmask entries of the given process, and notifies
+     * the owner MAC whether this buffer has units ready for retransmission.
+     *
+     * @param acid the H-arq process
+     */
+    void updateProcessMasks(unsigned char acid);
+
+    /**
+     * Sets the selected process, and notifies the owner MAC
+     * whether this buffer has a process selected for transmission.
+     *
+     * @param acid the H-arq process (HARQ_NONE if no process is selected)
+     */
+    void setSelectedAcid(unsigned char acid);
 };
 
 #endif
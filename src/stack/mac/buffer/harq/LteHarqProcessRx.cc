@@ -8,6 +8,7 @@
 //
 
 #include "stack/mac/buffer/harq/LteHarqProcessRx.h"
+#include "stack/mac/buffer/harq/LteHarqBufferRx.h"
 #include "stack/mac/layer/LteMacBase.h"
 #include "common/LteControlInfo.h"
 #include "stack/mac/packet/LteHarqFeedback_m.h"
@@ -23,6 +24,7 @@ LteHarqProcessRx::LteHarqProcessRx(unsigned char acid, LteMacBase *owner)
     result_.resize(MAX_CODEWORDS, false);
     acid_ = acid;
     macOwner_ = owner;
+    buffer_ = nullptr;
     transmissions_ = 0;
     maxHarqRtx_ = owner->par("maxHarqRtx");
 }
@@ -57,6 +59,7 @@ void LteHarqProcessRx::insertPdu(Codeword cw, Packet *pkt)
     rxTime_.at(cw) = NOW;
 
     transmissions_++;
+    notifyStatusChange();
 }
 
 bool LteHarqProcessRx::isEvaluated(Codeword cw)
@@ -95,6 +98,7 @@ Packet *LteHarqProcessRx::createFeedback(Codeword cw)
     {
         // NACK will be sent
         status_.at(cw) = RXHARQ_PDU_CORRUPTED;
+        notifyStatusChange();
 
         EV << "LteHarqProcessRx::createFeedback - tx number " << (unsigned int)transmissions_ << endl;
         if (transmissions_ == (maxHarqRtx_ + 1))
@@ -167,6 +171,7 @@ void LteHarqProcessRx::resetCodeword(Codeword cw)
     result_.at(cw) = false;
 
     transmissions_ = 0;
+    notifyStatusChange();
 }
 
 LteHarqProcessRx::~LteHarqProcessRx()
@@ -197,3 +202,19 @@ LteHarqProcessRx::getProcessStatus()
     }
     return ret;
 }
+
+void LteHarqProcessRx::notifyStatusChange()
+{
+    if (buffer_ != nullptr)
+        buffer_->updateCorruptedMask(acid_);
+}
+
+bool LteHarqProcessRx::hasCorruptedUnits() const
+{
+    for (unsigned int j = 0; j < status_.size(); j++)
+    {
+        if (status_[j] == RXHARQ_PDU_CORRUPTED)
+            return true;
+    }
+    return false;
+}
@@ -19,6 +19,7 @@ typedef std::vector<std::vector<RxUnitStatus> > RxBufferStatus;
 
 class LteMacBase;
 class LteMacPdu;
+class LteHarqBufferRx;
 class LteHarqFeedback;
 
 /**
@@ -54,6 +55,9 @@ class SIMULTE_API LteHarqProcessRx
     /// mac module to manage errors (endSimulation)
     LteMacBase *macOwner_;
 
+    /// buffer containing this process, notified when units get or leave the corrupted status
+    LteHarqBufferRx *buffer_;
+
     /// Number of (re)transmissions for current pdu (N.B.: values are 1,2,3,4)
     unsigned char transmissions_;
 
@@ -121,6 +125,15 @@ class SIMULTE_API LteHarqProcessRx
      */
 
     virtual std::vector<RxUnitStatus> getProcessStatus();
+
+    /**
+     * Checks whether any unit holds a corrupted PDU, i.e. one waiting for retransmission.
+     * Cheaper than inspecting getProcessStatus().
+     *
+     * @return true if at least one unit is corrupted, false otherwise
+     */
+    bool hasCorruptedUnits() const;
+
     /**
      * Extracts a pdu that can be passed to mac layer and reset process status.
      *
@@ -138,6 +151,14 @@ class SIMULTE_API LteHarqProcessRx
      */
     virtual void resetCodeword(Codeword cw);
 
+    /**
+     * Sets the buffer containing this process
+     */
+    void setBuffer(LteHarqBufferRx *buffer)
+    {
+        buffer_ = buffer;
+    }
+
     /**
      * @return number of codewords available for this process (set to MAX_CODEWORDS by default)
      */
@@ -149,6 +170,10 @@ class SIMULTE_API LteHarqProcessRx
     virtual ~LteHarqProcessRx();
 
   protected:
+    /**
+     * Notifies the containing buffer that the status of a unit has changed
+     */
+    void notifyStatusChange();
 };
 
 #endif
@@ -27,10 +27,12 @@ LteHarqBufferRxD2D::LteHarqBufferRxD2D(unsigned int num, LteMacBase *owner, MacN
     processes_.resize(numHarqProcesses_);
     totalRcvdBytes_ = 0;
     isMulticast_ = isMulticast;
+    corruptedProcMask_ = 0;
 
     for (unsigned int i = 0; i < numHarqProcesses_; i++)
     {
         processes_[i] = new LteHarqProcessRxD2D(i, macOwner_);
+        processes_[i]->setBuffer(this);
     }
 
     /* Signals initialization: those are used to gather statistics */
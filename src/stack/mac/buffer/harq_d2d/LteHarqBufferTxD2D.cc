@@ -23,6 +23,7 @@ LteHarqBufferTxD2D::LteHarqBufferTxD2D(unsigned int numProc, LteMacBase *owner,
     {
         (*processes_)[i] = new LteHarqProcessTxD2D(i, MAX_CODEWORDS, numProc_, macOwner_, dstMac);
     }
+    initProcessMasks();
 }
 
 void LteHarqBufferTxD2D::receiveHarqFeedback(LteHarqFeedback *fbpkt)
@@ -60,6 +61,7 @@ void LteHarqBufferTxD2D::receiveHarqFeedback(LteHarqFeedback *fbpkt)
     {
         numEmptyProc_++;
     }
+    updateProcessMasks(acid);
 
     // debug output
     const char *ack = result ? "ACK" : "NACK";
@@ -75,6 +75,7 @@ Packet *LteHarqProcessRxD2D::createFeedback(Codeword cw)
         {
             // NACK will be sent
             status_.at(cw) = RXHARQ_PDU_CORRUPTED;
+            notifyStatusChange();
 
             EV << "LteHarqProcessRx::createFeedback - tx number " << (unsigned int)transmissions_ << endl;
             if (transmissions_ == (maxHarqRtx_ + 1))
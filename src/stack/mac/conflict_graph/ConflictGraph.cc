@@ -18,7 +18,7 @@ using namespace omnetpp;
  */
 ConflictGraph::ConflictGraph(LteMacEnbD2D* macEnb, bool reuseD2D, bool reuseD2DMulti)
 {
-    conflictGraph_.clear();
+    rowWords_ = 0;
     macEnb_ = macEnb;
     cellInfo_ = macEnb_->getCellInfo();
 
@@ -39,66 +39,104 @@ ConflictGraph::~ConflictGraph()
 // reset Conflict Graph
 void ConflictGraph::clearConflictGraph()
 {
-    conflictGraph_.clear();
+    vertices_.clear();
+    edges_.clear();
+    rowWords_ = 0;
+    srcVertices_.clear();
+}
+
+void ConflictGraph::setVertices(const std::vector<CGVertex>& vertices)
+{
+    vertices_ = vertices;
+    rowWords_ = (vertices_.size() + 63) / 64;
+    edges_.assign(vertices_.size() * rowWords_, 0);
+
+    srcVertices_.clear();
+    for (unsigned int i = 0; i < vertices_.size(); i++)
+        srcVertices_[vertices_[i].srcId].push_back(i);
 }
 
 void ConflictGraph::computeConflictGraph()
 {
     EV << " ConflictGraph::computeConflictGraph - START "<<endl;
 
-    // --- remove the old one --- //
-    clearConflictGraph();
-
     // --- find the vertices of the graph by scanning the peering map --- //
     std::vector<CGVertex> vertices;
     findVertices(vertices);
     EV << " ConflictGraph::computeConflictGraph - " << vertices.size() << " vertices found" << endl;
 
     // --- for each CGVertex, find the interfering vertices --- //
-    findEdges(vertices);
+    if (vertices == vertices_)
+    {
+        // same vertices: only the edges of the moving ones change
+        findEdges(true);
+    }
+    else
+    {
+        // --- replace the old one --- //
+        setVertices(vertices);
+        findEdges(false);
+    }
 
     EV << " ConflictGraph::computeConflictGraph - END "<<endl;
 
 }
 
+bool ConflictGraph::checkConflict(MacNodeId nodeIdA, MacNodeId nodeIdB) const
+{
+    std::map<MacNodeId, std::vector<unsigned int> >::const_iterator ait = srcVertices_.find(nodeIdA);
+    if (ait == srcVertices_.end())
+        return false;
+    std::map<MacNodeId, std::vector<unsigned int> >::const_iterator bit = srcVertices_.find(nodeIdB);
+    if (bit == srcVertices_.end())
+        return false;
+
+    for (unsigned int i = 0; i < ait->second.size(); i++)
+    {
+        for (unsigned int j = 0; j < bit->second.size(); j++)
+        {
+            if (isConflicting(ait->second[i], bit->second[j]))
+                return true;
+        }
+    }
+    return false;
+}
+
 void ConflictGraph::printConflictGraph()
 {
     EV << " ConflictGraph::printConflictGraph "<<endl;
 
-    if (conflictGraph_.empty())
+    if (vertices_.empty())
     {
         EV << " ConflictGraph::printConflictGraph - No reuse enabled "<<endl;
         return;
     }
 
     EV << "              ";
-    CGMatrix::iterator it = conflictGraph_.begin(), et = conflictGraph_.end();
-    for (; it != et; ++it)
+    for (unsigned int i = 0; i < vertices_.size(); i++)
     {
-        if (it->first.isMulticast())
-            EV << "| (" << it->first.srcId << ", *  ) ";
+        if (vertices_[i].isMulticast())
+            EV << "| (" << vertices_[i].srcId << ", *  ) ";
         else
-            EV << "| (" << it->first.srcId << "," << it->first.dstId <<") ";
+            EV << "| (" << vertices_[i].srcId << "," << vertices_[i].dstId <<") ";
     }
     EV << endl;
 
-    it = conflictGraph_.begin();
-    for (; it != et; ++it)
+    for (unsigned int i = 0; i < vertices_.size(); i++)
     {
-        if (it->first.isMulticast())
-            EV << "| (" << it->first.srcId << ", *  ) ";
+        if (vertices_[i].isMulticast())
+            EV << "| (" << vertices_[i].srcId << ", *  ) ";
         else
-            EV << "| (" << it->first.srcId << "," << it->first.dstId <<") ";
-        std::map<CGVertex, bool>::iterator jt = it->second.begin();
-        for (; jt != it->second.end(); ++jt)
+            EV << "| (" << vertices_[i].srcId << "," << vertices_[i].dstId <<") ";
+        for (unsigned int j = 0; j < vertices_.size(); j++)
         {
-            if (it->first == jt->first)
+            if (i == j)
             {
                 EV << "|      -      ";
             }
             else
             {
-                EV << "|      " << jt->second << "      ";
+                EV << "|      " << isConflicting(i, j) << "      ";
             }
         }
         EV << endl;
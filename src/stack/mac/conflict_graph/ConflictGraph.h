@@ -54,7 +54,6 @@ public:
     }
 };
 
-typedef std::map<CGVertex, std::map<CGVertex, bool> > CGMatrix;
 class LteCellInfo;
 class LteMacEnbD2D;
 
@@ -78,8 +77,15 @@ protected:
     // Reference to the LteCellInfo
     LteCellInfo *cellInfo_;
 
-    // Conflict Graph
-    CGMatrix conflictGraph_;
+    // vertices of the Conflict Graph, identified by their (dense) index in this vector
+    std::vector<CGVertex> vertices_;
+
+    // Conflict Graph, as a packed bit-matrix: bit j of row i is set if vertices i and j conflict
+    std::vector<uint64_t> edges_;
+    unsigned int rowWords_;
+
+    // indices of the vertices transmitted by each UE
+    std::map<MacNodeId, std::vector<unsigned int> > srcVertices_;
 
     // flag for enabling/disabling sharing models
     bool reuseD2D_;
@@ -88,8 +94,34 @@ protected:
     // reset Conflict Graph
     void clearConflictGraph();
 
+    // set the vertices of the graph, without any edge
+    void setVertices(const std::vector<CGVertex>& vertices);
+
+    // add or remove the edge between vertices i and j (in both directions)
+    void setEdge(unsigned int i, unsigned int j, bool conflict)
+    {
+        uint64_t bit = (uint64_t)1 << (j & 63);
+        uint64_t bitT = (uint64_t)1 << (i & 63);
+        if (conflict)
+        {
+            edges_[i * rowWords_ + (j >> 6)] |= bit;
+            edges_[j * rowWords_ + (i >> 6)] |= bitT;
+        }
+        else
+        {
+            edges_[i * rowWords_ + (j >> 6)] &= ~bit;
+            edges_[j * rowWords_ + (i >> 6)] &= ~bitT;
+        }
+    }
+
     virtual void findVertices(std::vector<CGVertex>& vertices) = 0;
-    virtual void findEdges(const std::vector<CGVertex>& vertices) = 0;
+
+    /*
+     * Find the edges among vertices_. If update is true, the vertices are the same as in
+     * the previous computation and the edges found then are still in place, so that only
+     * the edges of the vertices whose endpoints moved need to be recomputed
+     */
+    virtual void findEdges(bool update) = 0;
 
 public:
    
@@ -102,7 +134,18 @@ public:
     // print Conflict Graph - for debug
     void printConflictGraph();
 
-    const CGMatrix* getConflictGraph() { return &conflictGraph_; }
+    unsigned int getNumVertices() const { return vertices_.size(); }
+
+    const CGVertex& getVertex(unsigned int i) const { return vertices_[i]; }
+
+    // returns true if there is an edge between vertices i and j
+    bool isConflicting(unsigned int i, unsigned int j) const
+    {
+        return (edges_[i * rowWords_ + (j >> 6)] >> (j & 63)) & 1;
+    }
+
+    // returns true if a link transmitted by nodeIdA conflicts with a link transmitted by nodeIdB
+    bool checkConflict(MacNodeId nodeIdA, MacNodeId nodeIdB) const;
 };
 
 #endif	/* CONFLICTGRAPH_H */
@@ -7,6 +7,7 @@
 // and cannot be removed from it.
 //
 
+#include <algorithm>
 #include "stack/mac/conflict_graph/DistanceBasedConflictGraph.h"
 #include "stack/phy/layer/LtePhyBase.h"
 
@@ -27,6 +28,7 @@ DistanceBasedConflictGraph::DistanceBasedConflictGraph(LteMacEnbD2D* macEnb, boo
     d2dInterferenceRadius_ = -1.0;
     d2dMultiTransmissionRadius_ = -1.0;
     d2dMultiInterferenceRadius_ = -1.0;
+    gridCellSize_ = 0.0;
 
     // get the reference to the PHY layer of the eNB
     phyEnb_ = check_and_cast<LtePhyBase*>(macEnb_->getParentModule()->getSubmodule("phy"));
@@ -37,6 +39,41 @@ void DistanceBasedConflictGraph::setThresholds(double d2dInterferenceRadius, dou
     d2dInterferenceRadius_ = d2dInterferenceRadius;
     d2dMultiTransmissionRadius_ = d2dMultiTransmissionRadius;
     d2dMultiInterferenceRadius_ = d2dMultiInterferenceRadius;
+    updateGridCellSize();
+}
+
+void DistanceBasedConflictGraph::updateGridCellSize()
+{
+    // the grid can be used only if all the pairs of vertices that may occur
+    // are checked against distance thresholds
+    gridCellSize_ = 0.0;
+    if (reuseD2D_)
+    {
+        if (d2dInterferenceRadius_ <= 0.0)
+            return;
+        gridCellSize_ = std::max(gridCellSize_, d2dInterferenceRadius_);
+    }
+    if (reuseD2DMulti_)
+    {
+        if (d2dMultiTransmissionRadius_ <= 0.0 || d2dMultiInterferenceRadius_ <= 0.0)
+        {
+            gridCellSize_ = 0.0;
+            return;
+        }
+        gridCellSize_ = std::max(gridCellSize_, d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_);
+        if (reuseD2D_)
+            gridCellSize_ = std::max(gridCellSize_, d2dMultiTransmissionRadius_ + d2dInterferenceRadius_);
+    }
+}
+
+int64_t DistanceBasedConflictGraph::getCell(const Coord& coord) const
+{
+    // the grid is two-dimensional: cells spanning all the heights only make it less selective
+    double x = floor(coord.x / gridCellSize_);
+    double y = floor(coord.y / gridCellSize_);
+    x = std::max(std::min(x, (double)INT32_MAX - 1), (double)INT32_MIN + 1);
+    y = std::max(std::min(y, (double)INT32_MAX - 1), (double)INT32_MIN + 1);
+    return ((int64_t)x << 32) | (uint32_t)(int32_t)y;
 }
 
 double DistanceBasedConflictGraph::getDbmFromDistance(double distance)
@@ -86,210 +123,160 @@ void DistanceBasedConflictGraph::findVertices(std::vector<CGVertex>& vertices)
     }
 }
 
-void DistanceBasedConflictGraph::findEdges(const std::vector<CGVertex>& vertices)
+bool DistanceBasedConflictGraph::computeEdge(unsigned int i, unsigned int j)
 {
-    std::vector<CGVertex>::const_iterator vit = vertices.begin(), vet = vertices.end();
-    for (; vit != vet; ++vit)
+    const CGVertex& v1 = vertices_[i];
+    const CGVertex& v2 = vertices_[j];
+
+    // Depending on the considered pair of vertices, we are in one of the following cases:
+    //  -> P2P-P2P
+    //  -> P2P-P2MP
+    //  -> P2MP-P2P
+    //  -> P2MP-P2MP
+    //
+    // Each case has a different condition to be verified. The condition can be based on either
+    // distance or dBm thresholds, depending on whether distance thresholds are initialized or not
+
+    if (!v1.isMulticast() && !v2.isMulticast())  // check P2P-P2P conflict
     {
-        CGVertex v1 = *vit;
+        double distance1 = srcCoord_[i].distance(dstCoord_[j]);
+        double distance2 = srcCoord_[j].distance(dstCoord_[i]);
 
-        std::vector<CGVertex>::const_iterator it = vit;
-        for (; it != vet; ++it)
-        {
-            CGVertex v2 = *it;
+        if (d2dInterferenceRadius_ > 0.0) // distance threshold initialized
+            return (distance1 < d2dInterferenceRadius_ || distance2 < d2dInterferenceRadius_);
 
-            if (v1 == v2)
-            {
-                // self conflict
-                conflictGraph_[v1][v2] = true;
-                conflictGraph_[v2][v1] = true;
-                continue;
-            }
+        // compare path-loss attenuations
+        return (getDbmFromDistance(distance1) < d2dDbmThreshold_ || getDbmFromDistance(distance2) < d2dDbmThreshold_);
+    }
+    else if (!v1.isMulticast() && v2.isMulticast())   // check P2P-P2MP conflict
+    {
+        // distance between the transmitters
+        double distance = srcCoord_[i].distance(srcCoord_[j]);
 
-            // Depending on the considered pair of vertices, we are in one of the following cases:
-            //  -> P2P-P2P
-            //  -> P2P-P2MP
-            //  -> P2MP-P2P
-            //  -> P2MP-P2MP
-            //
-            // Each case has a different condition to be verified. The condition can be based on either
-            // distance or dBm thresholds, depending on whether distance thresholds are initialized or not
+        if (d2dMultiTransmissionRadius_ > 0.0 && d2dInterferenceRadius_ > 0.0) // distance threshold initialized
+            return (distance < d2dMultiTransmissionRadius_ + d2dInterferenceRadius_);
 
+        // compare path-loss attenuations
+        return (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dDbmThreshold_);
+    }
+    else if (v1.isMulticast() && !v2.isMulticast())   // check P2MP-P2P conflict
+    {
+        // distance between v1's transmitter and v2's receiver
+        double distance = srcCoord_[i].distance(dstCoord_[j]);
 
-            if (!v1.isMulticast() && !v2.isMulticast())  // check P2P-P2P conflict
-            {
-                // obtain the position of v1's endpoints
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                Coord v1DestCoord = cellInfo_->getUePosition(v1.dstId);
-                // obtain the position of v2's endpoints
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
-                Coord v2DestCoord = cellInfo_->getUePosition(v2.dstId);
-                double distance1 = v1SenderCoord.distance(v2DestCoord);
-                double distance2 = v2SenderCoord.distance(v1DestCoord);
-
-                if (d2dInterferenceRadius_ > 0.0) // distance threshold initialized
-                {
-                    // compare distances
+        if (d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
+            return (distance < d2dMultiInterferenceRadius_);
 
-                    if (distance1 < d2dInterferenceRadius_ || distance2 < d2dInterferenceRadius_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else
-                {
-                    // compare path-loss attenuations
+        // compare path-loss attenuations
+        return (getDbmFromDistance(distance) < d2dMultiInterfDbmThreshold_);
+    }
+    else    // check P2MP-P2MP conflict
+    {
+        // distance between the transmitters
+        double distance = srcCoord_[i].distance(srcCoord_[j]);
 
-                    if (getDbmFromDistance(distance1) < d2dDbmThreshold_ || getDbmFromDistance(distance2) < d2dDbmThreshold_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-            }
-            else if (!v1.isMulticast() && v2.isMulticast())   // check P2P-P2MP conflict
-            {
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2 transmitter
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
+        if (d2dMultiTransmissionRadius_ > 0.0 && d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
+            return (distance < d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_);
 
-                double distance = v1SenderCoord.distance(v2SenderCoord);
+        // compare path-loss attenuations
+        return (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dMultiInterfDbmThreshold_);
+    }
+}
 
-                if (d2dMultiTransmissionRadius_ > 0.0 && d2dInterferenceRadius_ > 0.0) // distance threshold initialized
-                {
-                    // compare distances
+void DistanceBasedConflictGraph::findEdges(bool update)
+{
+    unsigned int numVertices = vertices_.size();
+
+    // obtain the position of the endpoints, and find the vertices that moved since the last computation
+    std::vector<bool> moved(numVertices, !update);
+    unsigned int numMoved = 0;
+    srcCoord_.resize(numVertices);
+    dstCoord_.resize(numVertices);
+    for (unsigned int i = 0; i < numVertices; i++)
+    {
+        Coord srcCoord = cellInfo_->getUePosition(vertices_[i].srcId);
+        Coord dstCoord = vertices_[i].isMulticast() ? Coord() : cellInfo_->getUePosition(vertices_[i].dstId);
+        if (update && (srcCoord != srcCoord_[i] || dstCoord != dstCoord_[i]))
+            moved[i] = true;
+        if (moved[i])
+            numMoved++;
+        srcCoord_[i] = srcCoord;
+        dstCoord_[i] = dstCoord;
+    }
 
-                    if (distance < d2dMultiTransmissionRadius_ + d2dInterferenceRadius_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else
-                {
-                    // compare path-loss attenuations
+    EV << " DistanceBasedConflictGraph::findEdges - " << numMoved << " vertices to be updated" << endl;
+    if (numMoved == 0)
+        return;
 
-                    if (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dDbmThreshold_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
+    // remove the edges of the vertices that moved, and add the self conflicts
+    for (unsigned int i = 0; i < numVertices; i++)
+    {
+        if (!moved[i])
+            continue;
+        if (update)
+        {
+            for (unsigned int j = 0; j < numVertices; j++)
+                setEdge(i, j, false);
+        }
+        setEdge(i, i, true);
+    }
 
-            }
-            else if (v1.isMulticast() && !v2.isMulticast())   // check P2MP-P2P conflict
+    if (gridCellSize_ <= 0.0)
+    {
+        // path loss-based thresholds: check all the pairs involving a vertex that moved
+        for (unsigned int i = 0; i < numVertices; i++)
+        {
+            for (unsigned int j = i + 1; j < numVertices; j++)
             {
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2's receiveer
-                Coord v2DestCoord = cellInfo_->getUePosition(v2.dstId);
-
-                double distance = v1SenderCoord.distance(v2DestCoord);
-
-                if (d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
-                {
-                    // compare distances
-
-                    if (distance < d2dMultiInterferenceRadius_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else
-                {
-                    // compare path-loss attenuations
-
-                    if (getDbmFromDistance(distance) < d2dMultiInterfDbmThreshold_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-
-                }
+                if ((moved[i] || moved[j]) && computeEdge(i, j))
+                    setEdge(i, j, true);
             }
-            else if (v1.isMulticast() && v2.isMulticast())    // check P2MP-P2MP conflict
-            {
-                // obtain the position of v1's transmitter
-                Coord v1SenderCoord = cellInfo_->getUePosition(v1.srcId);
-                // obtain the position of v2 transmitter
-                Coord v2SenderCoord = cellInfo_->getUePosition(v2.srcId);
-
-                double distance = v1SenderCoord.distance(v2SenderCoord);
+        }
+        return;
+    }
 
-                if (d2dMultiTransmissionRadius_ > 0.0 && d2dMultiInterferenceRadius_ > 0.0) // distance threshold initialized
-                {
-                    // compare distances
+    // put the endpoints of all the vertices into the grid
+    grid_.clear();
+    for (unsigned int i = 0; i < numVertices; i++)
+    {
+        grid_[getCell(srcCoord_[i])].push_back(i);
+        if (!vertices_[i].isMulticast())
+            grid_[getCell(dstCoord_[i])].push_back(i);
+    }
 
-                    if (distance < d2dMultiTransmissionRadius_ + d2dMultiInterferenceRadius_)
-                    {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
-                    }
-                }
-                else
+    // each vertex is checked against the vertices with an endpoint in the cells adjacent to its own
+    // endpoints, which include all the vertices within interference distance
+    mark_.assign(numVertices, 0);
+    for (unsigned int i = 0; i < numVertices; i++)
+    {
+        unsigned int numEndpoints = vertices_[i].isMulticast() ? 1 : 2;
+        for (unsigned int e = 0; e < numEndpoints; e++)
+        {
+            int64_t cell = getCell(e == 0 ? srcCoord_[i] : dstCoord_[i]);
+            int64_t cx = cell >> 32;
+            int64_t cy = (int32_t)(cell & 0xffffffff);
+            for (int64_t dx = -1; dx <= 1; dx++)
+            {
+                for (int64_t dy = -1; dy <= 1; dy++)
                 {
-                    // compare path-loss attenuations
+                    std::unordered_map<int64_t, std::vector<unsigned int> >::iterator it =
+                        grid_.find(((cx + dx) << 32) | (uint32_t)(int32_t)(cy + dy));
+                    if (it == grid_.end())
+                        continue;
 
-                    if (getDbmFromDistance(distance) < d2dMultiTxDbmThreshold_ + d2dMultiInterfDbmThreshold_)
+                    for (unsigned int k = 0; k < it->second.size(); k++)
                     {
-                        // add edge to the conflict graph
-                        conflictGraph_[v1][v2] = true;
-                        conflictGraph_[v2][v1] = true;
-                    }
-                    else
-                    {
-                        conflictGraph_[v1][v2] = false;
-                        conflictGraph_[v2][v1] = false;
+                        // pairs are evaluated once, from the vertex with the lower index
+                        unsigned int j = it->second[k];
+                        if (j <= i || mark_[j] == i + 1)
+                            continue;
+                        mark_[j] = i + 1;
+
+                        if ((moved[i] || moved[j]) && computeEdge(i, j))
+                            setEdge(i, j, true);
                     }
                 }
             }
-
-        }  // end inner loop
-    } // end outer loop
+        }
+    }
 }
-
@@ -10,6 +10,7 @@
 #ifndef DISTANCEBASEDCONFLICTGRAPH_H
 #define	DISTANCEBASEDCONFLICTGRAPH_H
 
+#include <unordered_map>
 #include "stack/mac/conflict_graph/ConflictGraph.h"
 
 class SIMULTE_API DistanceBasedConflictGraph : public ConflictGraph
@@ -27,12 +28,35 @@ class SIMULTE_API DistanceBasedConflictGraph : public ConflictGraph
     // reference to the phy layer
     LtePhyBase* phyEnb_;
 
+    // position of the transmitter and of the receiver (P2P only) of each vertex,
+    // as of the last computation
+    std::vector<inet::Coord> srcCoord_;
+    std::vector<inet::Coord> dstCoord_;
+
+    // uniform grid over the endpoints of the vertices: two vertices can only conflict if
+    // they have endpoints in adjacent cells. Cells are as large as the largest interference
+    // distance, and the grid is only used when all the thresholds are distance-based
+    double gridCellSize_;
+    std::unordered_map<int64_t, std::vector<unsigned int> > grid_;
+
+    // per-vertex mark, used to evaluate each pair of vertices once
+    std::vector<unsigned int> mark_;
+
     // utility function to convert a distance to dBm according to the channel model
     double getDbmFromDistance(double distance);
 
+    // compute the grid cell size according to the enabled reuse modes and the thresholds
+    void updateGridCellSize();
+
+    // returns the grid cell containing the given position
+    int64_t getCell(const inet::Coord& coord) const;
+
+    // returns true if vertices i and j conflict (i < j)
+    bool computeEdge(unsigned int i, unsigned int j);
+
     // overridden functions
     virtual void findVertices(std::vector<CGVertex>& vertices);
-    virtual void findEdges(const std::vector<CGVertex>& vertices);
+    virtual void findEdges(bool update);
 
 public:
     DistanceBasedConflictGraph(LteMacEnbD2D* macEnb, bool reuseD2D, bool reuseD2DMulti, double dbmThresh);
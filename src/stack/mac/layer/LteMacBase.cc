@@ -18,6 +18,7 @@
 #include "corenetwork/binder/LteBinder.h"
 #include "corenetwork/lteCellInfo/LteCellInfo.h"
 #include "stack/mac/packet/LteHarqFeedback_m.h"
+#include "stack/mac/packet/LteControlBundle_m.h"
 #include "stack/mac/packet/LteMacPdu.h"
 #include "stack/mac/buffer/LteMacBuffer.h"
 #include "assert.h"
@@ -67,6 +68,19 @@ void LteMacBase::sendUpperPackets(cPacket* pkt)
 void LteMacBase::sendLowerPackets(cPacket* pkt)
 {
     EV << NOW << "LteMacBase::sendLowerPackets, Sending packet " << pkt->getName() << " on port MAC_to_PHY\n";
+
+    if (collectingControl_)
+    {
+        auto lteInfo = check_and_cast<inet::Packet*>(pkt)->getTag<UserControlInfo>();
+        if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT)
+        {
+            // hold the packet until the end of the TTI
+            std::pair<MacNodeId, unsigned short> key(lteInfo->getDestId(), lteInfo->getDirection());
+            pendingControl_[key].push_back(check_and_cast<inet::Packet*>(pkt));
+            return;
+        }
+    }
+
     // Send message
     updateUserTxParam(pkt);
     send(pkt,down_[OUT_GATE]);
@@ -76,12 +90,21 @@ void LteMacBase::sendLowerPackets(cPacket* pkt)
 
 /*
  * Ue with nodeId left the simulation. Ensure that no
- * signales will be emitted via the deleted node.
+ * signales will be emitted via the deleted node, and that
+ * no retransmission will be scheduled for or requested to it.
  */
-void LteMacBase::unregisterHarqBufferRx(MacNodeId nodeId){
+void LteMacBase::unregisterHarqBuffers(MacNodeId nodeId){
     HarqRxBuffers::iterator it = harqRxBuffers_.find(nodeId);
     if (it != harqRxBuffers_.end()){
+        // the buffer is kept, since pdus from the node may still be on the air
         it->second->unregister_macUe();
+        it->second->purgeCorruptedPdus();
+    }
+
+    HarqTxBuffers::iterator hit = harqTxBuffers_.find(nodeId);
+    if (hit != harqTxBuffers_.end()){
+        delete hit->second;
+        harqTxBuffers_.erase(hit);
     }
 }
 
@@ -120,6 +143,10 @@ void LteMacBase::fromPhy(cPacket *pktAux)
             if (binder_->hasUeHandoverTriggered(nodeId_) || binder_->hasUeHandoverTriggered(src))
                 return;
 
+            // the tx buffer is deleted when the peer leaves the simulation
+            if (binder_->getOmnetId(src) == 0)
+                return;
+
             throw cRuntimeError("Mac::fromPhy(): Received feedback for an unexisting H-ARQ tx buffer");
         }
 
@@ -249,6 +276,61 @@ bool LteMacBase::bufferizePacket(cPacket* pkt)
     return true;
 }
 
+unsigned int LteMacBase::bufferizeFluidData(const FlowControlInfo& info, unsigned int bytes)
+{
+    Enter_Method_Silent("bufferizeFluidData");
+
+    FlowControlInfo lteInfo(info);
+    Direction dir = (Direction) lteInfo.getDirection();
+    if (dir != DL && dir != UL)
+        throw cRuntimeError("LteMacBase::bufferizeFluidData - unsupported direction %s", dirToA(dir).c_str());
+
+    MacCid cid = ctrlInfoToMacCid(&lteInfo);
+
+    LteMacBuffer* vqueue;
+    LteMacBufferMap::iterator it = macBuffers_.find(cid);
+    if (it == macBuffers_.end())
+    {
+        vqueue = new LteMacBuffer();
+        macBuffers_[cid] = vqueue;
+        fluidConnections_.insert(cid);
+
+        // make a copy of lte control info and store it to traffic descriptors map
+        connDesc_[cid] = lteInfo;
+        // register connection to lcg map.
+        LteTrafficClass tClass = (LteTrafficClass) lteInfo.getTraffic();
+        lcgMap_.insert(LcgPair(tClass, CidBufferPair(cid, vqueue)));
+
+        EV << "LteMacBuffers : Using new fluid buffer on node: " << MacCidToNodeId(cid) << " for Lcid: " << MacCidToLcid(cid) << "\n";
+    }
+    else
+    {
+        vqueue = it->second;
+        if (!isFluidConnection(cid))
+            throw cRuntimeError("LteMacBase::bufferizeFluidData - connection %d is already fed by the RLC", cid);
+    }
+
+    // the queue size bounds the credit as it bounds the SDUs of the other connections
+    unsigned int accepted = bytes;
+    if (queueSize_ != 0)
+    {
+        unsigned int occupancy = vqueue->getQueueOccupancy();
+        accepted = (occupancy >= (unsigned int) queueSize_) ? 0 : std::min(bytes, queueSize_ - occupancy);
+    }
+    if (accepted < bytes)
+    {
+        totalOverflowedBytes_ += bytes - accepted;
+        double sample = (double)totalOverflowedBytes_ / (NOW - getSimulation()->getWarmupPeriod());
+        emit((dir == DL) ? macBufferOverflowDl_ : macBufferOverflowUl_, sample);
+
+        EV << "LteMacBuffers : fluid queue " << cid << " is full - dropping " << bytes - accepted << " bytes of credit\n";
+    }
+    if (accepted > 0)
+        vqueue->pushBack(PacketInfo(accepted, NOW));
+
+    return accepted;
+}
+
 void LteMacBase::deleteQueues(MacNodeId nodeId)
 {
     LteMacBuffers::iterator mit;
@@ -285,6 +367,15 @@ void LteMacBase::deleteQueues(MacNodeId nodeId)
         }
     }
 
+    std::set<MacCid>::iterator fit;
+    for (fit = fluidConnections_.begin(); fit != fluidConnections_.end(); )
+    {
+        if (MacCidToNodeId(*fit) == nodeId)
+            fluidConnections_.erase(fit++);
+        else
+            ++fit;
+    }
+
     // delete H-ARQ buffers
     HarqTxBuffers::iterator hit;
     for (hit = harqTxBuffers_.begin(); hit != harqTxBuffers_.end(); )
@@ -342,6 +433,9 @@ void LteMacBase::initialize(int stage)
 
         harqProcesses_ = par("harqProcesses");
 
+        aggregateControlFrames_ = par("aggregateControlFrames");
+        collectingControl_ = false;
+
         /* Start TTI tick */
         ttiTick_ = new cMessage("ttiTick_");
         ttiTick_->setSchedulingPriority(1);        // TTI TICK after other messages
@@ -366,6 +460,7 @@ void LteMacBase::initialize(int stage)
         sentPacketToLowerLayer = registerSignal("sentPacketToLowerLayer");
 
         measuredItbs_ = registerSignal("measuredItbs");
+        fluidServedBytes_ = registerSignal("fluidServedBytes");
         WATCH(queueSize_);
         WATCH(nodeId_);
         WATCH_MAP(mbuf_);
@@ -377,7 +472,11 @@ void LteMacBase::handleMessage(cMessage* msg)
 {
     if (msg->isSelfMessage())
     {
+        collectingControl_ = aggregateControlFrames_;
         handleSelfMessage();
+        collectingControl_ = false;
+        if (!pendingControl_.empty())
+            flushControlPackets();
         scheduleAt(NOW + TTI, ttiTick_);
         return;
     }
@@ -393,7 +492,11 @@ void LteMacBase::handleMessage(cMessage* msg)
         // message from PHY_to_MAC gate (from lower layer)
         emit(receivedPacketFromLowerLayer, pkt);
         nrFromLower_++;
-        fromPhy(pkt);
+        auto lteInfo = check_and_cast<inet::Packet*>(pkt)->getTag<UserControlInfo>();
+        if (lteInfo->getFrameType() == CTRLBUNDLEPKT)
+            unbundleControlPackets(check_and_cast<inet::Packet*>(pkt));
+        else
+            fromPhy(pkt);
     }
     else
     {
@@ -405,6 +508,66 @@ void LteMacBase::handleMessage(cMessage* msg)
     return;
 }
 
+void LteMacBase::flushControlPackets()
+{
+    std::map<std::pair<MacNodeId, unsigned short>, std::vector<inet::Packet*> >::iterator it;
+    for (it = pendingControl_.begin(); it != pendingControl_.end(); ++it)
+    {
+        std::vector<inet::Packet*>& pkts = it->second;
+        if (pkts.size() == 1)
+        {
+            // nothing to bundle
+            sendLowerPackets(pkts.front());
+            continue;
+        }
+
+        // the control info of the first packet is used for the whole bundle,
+        // each entry keeps the control info of its own packet
+        auto bundle = new inet::Packet("controlBundle");
+        *(bundle->addTag<UserControlInfo>()) = *(pkts.front()->getTag<UserControlInfo>());
+        bundle->getTagForUpdate<UserControlInfo>()->setFrameType(CTRLBUNDLEPKT);
+
+        for (unsigned int i = 0; i < pkts.size(); i++)
+        {
+            auto entry = inet::makeShared<LteControlBundleEntry>();
+            entry->setFrameType(pkts[i]->getTag<UserControlInfo>()->getFrameType());
+            entry->setBitLength(pkts[i]->getDataLength().get());
+            entry->setControlInfo(*(pkts[i]->getTag<UserControlInfo>()));
+            bundle->insertAtBack(entry);
+            bundle->insertAtBack(pkts[i]->peekData());
+            delete pkts[i];
+        }
+
+        EV << NOW << " LteMacBase::flushControlPackets - bundling " << pkts.size() << " control packets for node " << it->first.first << endl;
+        sendLowerPackets(bundle);
+    }
+    pendingControl_.clear();
+}
+
+void LteMacBase::unbundleControlPackets(inet::Packet* bundle)
+{
+    EV << NOW << " LteMacBase::unbundleControlPackets - node " << nodeId_ << " received a control bundle" << endl;
+
+    auto bundleInfo = bundle->getTag<UserControlInfo>();
+    while (bundle->getDataLength() > inet::b(0))
+    {
+        auto entry = bundle->popAtFront<LteControlBundleEntry>();
+        auto content = bundle->popAtFront(inet::b(entry->getBitLength()));
+
+        auto pkt = new inet::Packet((entry->getFrameType() == GRANTPKT) ? "LteGrant" : "harqFeedback", content);
+        auto lteInfo = pkt->addTag<UserControlInfo>();
+        *lteInfo = entry->getControlInfo();
+
+        // the fields set by the PHY layers refer to the whole bundle
+        lteInfo->setCoord(bundleInfo->getCoord());
+        lteInfo->setTxPower(bundleInfo->getTxPower());
+        lteInfo->setDestId(bundleInfo->getDestId());
+        lteInfo->setDeciderResult(bundleInfo->getDeciderResult());
+        fromPhy(pkt);
+    }
+    delete bundle;
+}
+
 void LteMacBase::finish()
 {
 }
@@ -11,6 +11,7 @@
 #define _LTE_LTEMACBASE_H_
 
 #include "common/LteCommon.h"
+#include "common/DenseBitmask.h"
 
 class LteHarqBufferTx;
 class LteHarqBufferRx;
@@ -66,6 +67,7 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
     ::omnetpp::simsignal_t sentPacketToUpperLayer;
     ::omnetpp::simsignal_t sentPacketToLowerLayer;
     ::omnetpp::simsignal_t measuredItbs_;
+    ::omnetpp::simsignal_t fluidServedBytes_;
 
     /*
      * Data Structures
@@ -103,15 +105,42 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
     /// Mac Sdu Virtual Buffers
     LteMacBufferMap macBuffers_;
 
+    /// Connections fed with byte credit by an aggregate traffic source, rather than with SDUs by the RLC
+    std::set<MacCid> fluidConnections_;
+
     /// List of pdus finalized for each user on each codeword
     MacPduList macPduList_;
 
+    /// Headers of the pdus in macPduList_, while SDUs are being attached to them
+    MacPduHeaderList macPduHeaders_;
+
     /// Harq Tx Buffers
     HarqTxBuffers harqTxBuffers_;
 
     /// Harq Rx Buffers
     HarqRxBuffers harqRxBuffers_;
 
+    /// Ids of the nodes whose Harq Tx Buffer has a process selected for transmission
+    DenseBitmask harqTxSelected_;
+
+    /// Ids extracted from harqTxSelected_ when flushing the Harq Tx Buffers, reused at every TTI
+    std::vector<MacNodeId> harqTxSelectedIds_;
+
+    /// Ids of the nodes whose Harq Tx Buffer has units ready for retransmission
+    DenseBitmask harqTxReady_;
+
+    /// Ids of the nodes whose Harq Rx Buffer has corrupted units, i.e. waiting for retransmission
+    DenseBitmask harqRxCorrupted_;
+
+    /// If true, the control packets generated within a TTI are bundled per destination
+    bool aggregateControlFrames_;
+
+    /// True while the TTI is being handled, i.e. while control packets are being collected
+    bool collectingControl_;
+
+    /// Control packets (H-ARQ feedback and grants) collected within the current TTI, per destination and direction
+    std::map<std::pair<MacNodeId, unsigned short>, std::vector<inet::Packet*> > pendingControl_;
+
     /* Connection Descriptors
      * Holds flow related infos
      */
@@ -159,6 +188,27 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
      */
     virtual void deleteQueues(MacNodeId nodeId);
 
+    /**
+     * bufferizeFluidData() adds byte credit to the virtual buffer of a
+     * connection fed by an aggregate traffic source (see FluidTrafficSource),
+     * creating the connection at the first call.
+     * The connection is scheduled as any other one, but no SDU is requested
+     * to the RLC for it: the granted bytes just consume the credit.
+     *
+     * @param info descriptor of the connection
+     * @param bytes credit to be added
+     * @return the amount of credit that fits in the buffer (the rest is dropped)
+     */
+    virtual unsigned int bufferizeFluidData(const FlowControlInfo& info, unsigned int bytes);
+
+    /**
+     * Returns true if the given connection is fed by an aggregate traffic source
+     */
+    bool isFluidConnection(MacCid cid) const
+    {
+        return fluidConnections_.find(cid) != fluidConnections_.end();
+    }
+
     //* public utility function - drops ownership of an object
     void dropObj(cOwnedObject* obj)
     {
@@ -214,6 +264,36 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
         return &harqRxBuffers_;
     }
 
+    // Returns the ids of the nodes whose harq tx buffer has units ready for retransmission
+    const DenseBitmask& getHarqTxReady() const
+    {
+        return harqTxReady_;
+    }
+
+    // Updated by harq tx buffers when a process gets (de)selected for transmission
+    void setHarqTxSelected(MacNodeId id, bool selected)
+    {
+        harqTxSelected_.assign(id, selected);
+    }
+
+    // Updated by harq tx buffers when their processes change status
+    void setHarqTxReady(MacNodeId id, bool ready)
+    {
+        harqTxReady_.assign(id, ready);
+    }
+
+    // Returns the ids of the nodes whose harq rx buffer has corrupted units
+    const DenseBitmask& getHarqRxCorrupted() const
+    {
+        return harqRxCorrupted_;
+    }
+
+    // Updated by harq rx buffers when their processes change status
+    void setHarqRxCorrupted(MacNodeId id, bool corrupted)
+    {
+        harqRxCorrupted_.assign(id, corrupted);
+    }
+
     // Returns number of Harq Processes
     unsigned int harqProcesses() const
     {
@@ -252,7 +332,7 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
         return false;
     }
 
-    void unregisterHarqBufferRx(MacNodeId nodeId);
+    void unregisterHarqBuffers(MacNodeId nodeId);
 
     // visualization
     void refreshDisplay() const override;
@@ -363,6 +443,21 @@ class SIMULTE_API LteMacBase : public omnetpp::cSimpleModule
 
     /// Lower Layer Handler
     virtual void fromPhy(omnetpp::cPacket *pkt);
+
+    /**
+     * Sends the control packets collected within the current TTI.
+     * Packets addressed to the same destination are carried by a single
+     * CTRLBUNDLEPKT frame, each one preceded by a LteControlBundleEntry header
+     */
+    void flushControlPackets();
+
+    /**
+     * Splits a CTRLBUNDLEPKT frame into the bundled control packets, and
+     * handles each of them as if it had been received on its own
+     *
+     * @param bundle the received bundle, deleted once split
+     */
+    void unbundleControlPackets(inet::Packet* bundle);
 };
 
 #endif
@@ -191,6 +191,20 @@ bool LteMacEnb::getPfTmsAwareFlag(Direction dir)
         return par("pfTmsAwareUL");
 }
 
+unsigned int LteMacEnb::bufferizeFluidData(const FlowControlInfo& info, unsigned int bytes)
+{
+    Enter_Method_Silent();
+
+    if (info.getDirection() != DL)
+        throw cRuntimeError("LteMacEnb::bufferizeFluidData - only DL connections can be fed at the eNB");
+
+    unsigned int accepted = LteMacBase::bufferizeFluidData(info, bytes);
+    if (accepted > 0)
+        enbSchedulerDl_->backlog(idToMacCid(info.getDestId(), info.getLcid()));
+
+    return accepted;
+}
+
 void LteMacEnb::deleteQueues(MacNodeId nodeId)
 {
     Enter_Method_Silent();
@@ -307,6 +321,13 @@ void LteMacEnb::macSduRequest()
         // Codeword cw = it->first.second;
         MacNodeId destId = MacCidToNodeId(destCid);
 
+        // the scheduler has already drained the granted bytes from the credit of fluid connections
+        if (isFluidConnection(destCid))
+        {
+            emit(fluidServedBytes_, (long)enbSchedulerDl_->getGrantedBytes(destCid, it->first.second));
+            continue;
+        }
+
         // for each band, count the number of bytes allocated for this ue (dovrebbe essere per cid)
         unsigned int allocatedBytes = 0;
         int numBands = cellInfo_->getNumBands();
@@ -537,6 +558,7 @@ void LteMacEnb::macPduMake(MacCid cid)
     // detaching sdus from real buffers.
 
     macPduList_.clear();
+    macPduHeaders_.clear();
 
     //  Build a MAC pdu for each scheduled user on each codeword
     LteMacScheduleList::const_iterator it;
@@ -559,6 +581,7 @@ void LteMacEnb::macPduMake(MacCid cid)
         unsigned int sduPerCid = it->second;
         unsigned int grantedBlocks = 0;
         TxMode txmode;
+        Ptr<LteMacPdu> header = nullptr;
 
         while (sduPerCid > 0)
         {
@@ -570,43 +593,45 @@ void LteMacEnb::macPduMake(MacCid cid)
             }
 
             // Add SDU to PDU
-            // FIXME *move outside cycle* Find Mac Pkt
-            auto pit = macPduList_.find(pktId);
-
-            // No packets for this user on this codeword
-            if (pit == macPduList_.end())
+            if (header == nullptr)
             {
+                // No packets for this user on this codeword
+                auto hit = macPduHeaders_.find(pktId);
+                if (hit == macPduHeaders_.end())
+                {
+                    auto pkt = new Packet("LteMacPdu");
+                    auto uinfo = pkt->addTag<UserControlInfo>();
+                    uinfo->setSourceId(getMacNodeId());
+                    uinfo->setDestId(destId);
+                    uinfo->setDirection(DL);
 
-                auto pkt = new Packet("LteMacPdu");
-                pkt->addTagIfAbsent<UserControlInfo>()->setSourceId(getMacNodeId());
-                pkt->addTagIfAbsent<UserControlInfo>()->setDestId(destId);
-                pkt->addTagIfAbsent<UserControlInfo>()->setDirection(DL);
-
-                const UserTxParams& txInfo = amc_->computeTxParams(destId, DL);
+                    const UserTxParams& txInfo = amc_->computeTxParams(destId, DL);
 
-                UserTxParams* txPara = new UserTxParams(txInfo);
+                    UserTxParams* txPara = new UserTxParams(txInfo);
 
-                pkt->addTagIfAbsent<UserControlInfo>()->setUserTxParams(txPara);
-                txmode = txInfo.readTxMode();
-                RbMap rbMap;
+                    uinfo->setUserTxParams(txPara);
+                    txmode = txInfo.readTxMode();
+                    RbMap rbMap;
 
-                pkt->addTagIfAbsent<UserControlInfo>()->setTxMode(txmode);
-                pkt->addTagIfAbsent<UserControlInfo>()->setCw(cw);
+                    uinfo->setTxMode(txmode);
+                    uinfo->setCw(cw);
 
-                grantedBlocks = enbSchedulerDl_->readRbOccupation(destId, rbMap);
+                    grantedBlocks = enbSchedulerDl_->readRbOccupation(destId, rbMap);
 
-                pkt->addTagIfAbsent<UserControlInfo>()->setGrantedBlocks(rbMap);
-                pkt->addTagIfAbsent<UserControlInfo>()->setTotalGrantedBlocks(grantedBlocks);
-                macPacket = pkt;
+                    uinfo->setGrantedBlocks(rbMap);
+                    uinfo->setTotalGrantedBlocks(grantedBlocks);
+                    macPacket = pkt;
 
-                auto macPkt = makeShared<LteMacPdu>();
-                macPkt->setHeaderLength(MAC_HEADER);
-                macPacket->insertAtFront(macPkt);
-                macPduList_[pktId] = macPacket;
-            }
-            else
-            {
-                macPacket = pit->second;
+                    // the header is inserted into the packet once all SDUs have been attached
+                    header = makeShared<LteMacPdu>();
+                    header->setHeaderLength(MAC_HEADER);
+                    macPduList_[pktId] = macPacket;
+                    macPduHeaders_[pktId] = header;
+                }
+                else
+                {
+                    header = hit->second;
+                }
             }
             if (mbuf_[destCid]->getQueueLength() == 0)
             {
@@ -619,9 +644,7 @@ void LteMacEnb::macPduMake(MacCid cid)
             ASSERT(pkt != nullptr);
 
             drop(pkt);
-            auto macPkt =  macPacket->removeAtFront<LteMacPdu>();
-            macPkt->pushSdu(pkt);
-            macPacket->insertAtFront(macPkt);
+            header->pushSdu(pkt);
             sduPerCid--;
         }
     }
@@ -649,7 +672,8 @@ void LteMacEnb::macPduMake(MacCid cid)
         UnitList txList = (txBuf->firstAvailable());
 
         auto macPacket = pit->second;
-        auto header = macPacket->peekAtFront<LteMacPdu>();
+        auto header = macPduHeaders_[pit->first];
+        macPacket->insertAtFront(header);
 
         EV << "LteMacBase: pduMaker created PDU: " << header->str() << endl;
 
@@ -666,18 +690,24 @@ void LteMacEnb::macPduMake(MacCid cid)
             txBuf->insertPdu(txList.first, cw, macPacket);
         }
     }
+    macPduHeaders_.clear();
     EV << "------ END LteMacEnb::macPduMake ------\n";
 }
 
 void LteMacEnb::macPduUnmake(cPacket* pktAux)
 {
     auto pkt = check_and_cast<Packet*>(pktAux);
-    auto macPkt = pkt->removeAtFront<LteMacPdu>();
 
-    while (macPkt->hasSdu())
+    // the received PDU may share its content with the copy held by the sender's H-ARQ process,
+    // hence SDUs and CEs are read through a view rather than removing the (copied) header
+    auto macPkt = pkt->peekAtFront<LteMacPdu>();
+
+    std::vector<Packet*> sdus;
+    macPkt->dupSdus(sdus);
+    for (unsigned int i = 0; i < sdus.size(); ++i)
     {
         // Extract and send SDU
-        cPacket* upPkt = macPkt->popSdu();
+        cPacket* upPkt = sdus[i];
         take(upPkt);
 
         // TODO: upPkt->info()
@@ -685,17 +715,17 @@ void LteMacEnb::macPduUnmake(cPacket* pktAux)
         sendUpperPackets(upPkt);
     }
 
-    while (macPkt->hasCe())
+    const MacControlElementsList& ceList = macPkt->getCeList();
+    MacControlElementsList::const_iterator cit = ceList.begin();
+    for (; cit != ceList.end(); ++cit)
     {
         // Extract CE
         // TODO: vedere se bsr  per cid o lcid
-        MacBsr* bsr = check_and_cast<MacBsr*>(macPkt->popCe());
+        MacBsr bsr(*check_and_cast<MacBsr*>(*cit));
         auto lteInfo = pkt->getTag<UserControlInfo>();
         MacCid cid = idToMacCid(lteInfo->getSourceId(), 0);
-        bufferizeBsr(bsr, cid);
-        delete bsr;
+        bufferizeBsr(&bsr, cid);
     }
-    pkt->insertAtFront(macPkt);
 
     ASSERT(pkt->getOwner() == this);
     delete pkt;
@@ -920,9 +950,15 @@ void LteMacEnb::handleSelfMessage()
 
 void LteMacEnb::flushHarqBuffers()
 {
-    HarqTxBuffers::iterator it;
-    for (it = harqTxBuffers_.begin(); it != harqTxBuffers_.end(); it++)
-        it->second->sendSelectedDown();
+    // only visit the buffers having a process selected for transmission
+    harqTxSelectedIds_.clear();
+    harqTxSelected_.getKeys(harqTxSelectedIds_);
+    for (unsigned int i = 0; i < harqTxSelectedIds_.size(); i++)
+    {
+        HarqTxBuffers::iterator it = harqTxBuffers_.find(harqTxSelectedIds_[i]);
+        if (it != harqTxBuffers_.end())
+            it->second->sendSelectedDown();
+    }
 }
 
 void LteMacEnb::macHandleFeedbackPkt(cPacket *pktAux)
@@ -184,6 +184,13 @@ class SIMULTE_API LteMacEnb : public LteMacBase
      */
     virtual void deleteQueues(MacNodeId nodeId) override;
 
+    /**
+     * bufferizeFluidData() on ENB performs actions
+     * from base class and also notifies the DL scheduler
+     * of the backlogged connection
+     */
+    virtual unsigned int bufferizeFluidData(const FlowControlInfo& info, unsigned int bytes) override;
+
     /**
      * Getter for AMC module
      */
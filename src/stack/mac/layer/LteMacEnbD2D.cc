@@ -145,12 +145,17 @@ void LteMacEnbD2D::handleSelfMessage()
 void LteMacEnbD2D::macPduUnmake(cPacket* pktAux)
 {
     auto pkt = check_and_cast<Packet *>(pktAux);
-    auto macPkt = pkt->removeAtFront<LteMacPdu>();
 
-    while (macPkt->hasSdu())
+    // the received PDU may share its content with the copy held by the sender's H-ARQ process,
+    // hence SDUs and CEs are read through a view rather than removing the (copied) header
+    auto macPkt = pkt->peekAtFront<LteMacPdu>();
+
+    std::vector<Packet*> sdus;
+    macPkt->dupSdus(sdus);
+    for (unsigned int i = 0; i < sdus.size(); ++i)
     {
         // Extract and send SDU
-        auto upPkt = check_and_cast<Packet *>(macPkt->popSdu());
+        auto upPkt = sdus[i];
         take(upPkt);
 
         EV << "LteMacEnbD2D: pduUnmaker extracted SDU" << endl;
@@ -169,20 +174,21 @@ void LteMacEnbD2D::macPduUnmake(cPacket* pktAux)
         sendUpperPackets(upPkt);
     }
 
-    while (macPkt->hasCe())
+    const MacControlElementsList& ceList = macPkt->getCeList();
+    MacControlElementsList::const_iterator cit = ceList.begin();
+    for (; cit != ceList.end(); ++cit)
     {
         // Extract CE
         // TODO: vedere se   per cid o lcid
-        MacBsr* bsr = check_and_cast<MacBsr*>(macPkt->popCe());
+        MacBsr bsr(*check_and_cast<MacBsr*>(*cit));
         auto lteInfo = pkt->getTag<UserControlInfo>();
         LogicalCid lcid = lteInfo->getLcid();  // one of SHORT_BSR or D2D_MULTI_SHORT_BSR
 
         MacCid cid = idToMacCid(lteInfo->getSourceId(), lcid); // this way, different connections from the same UE (e.g. one UL and one D2D)
                                                                // obtain different CIDs. With the inverse operation, you can get
                                                                // the LCID and discover if the connection is UL or D2D
-        bufferizeBsr(bsr, cid);
+        bufferizeBsr(&bsr, cid);
     }
-    pkt->insertAtFront(macPkt);
 
     delete pkt;
 }
@@ -524,9 +530,15 @@ void LteMacEnbD2D::macHandleD2DModeSwitch(cPacket* pktAux)
 
 void LteMacEnbD2D::flushHarqBuffers()
 {
-    HarqTxBuffers::iterator it;
-    for (it = harqTxBuffers_.begin(); it != harqTxBuffers_.end(); it++)
-        it->second->sendSelectedDown();
+    // only visit the buffers having a process selected for transmission
+    harqTxSelectedIds_.clear();
+    harqTxSelected_.getKeys(harqTxSelectedIds_);
+    for (unsigned int i = 0; i < harqTxSelectedIds_.size(); i++)
+    {
+        HarqTxBuffers::iterator it = harqTxBuffers_.find(harqTxSelectedIds_[i]);
+        if (it != harqTxBuffers_.end())
+            it->second->sendSelectedDown();
+    }
 
     // flush mirror buffer
     HarqBuffersMirrorD2D::iterator mit;
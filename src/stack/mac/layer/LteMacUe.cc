@@ -201,6 +201,13 @@ int LteMacUe::macSduRequest()
 
         EV << NOW <<" LteMacUe::macSduRequest - cid[" << destCid << "] - sdu size[" << sduSize<< "B] - " << allocatedBytes[cw] << " bytes left on codeword " << cw << endl;
 
+        // the LCG scheduler has already drained the granted bytes from the credit of fluid connections
+        if (isFluidConnection(destCid))
+        {
+            emit(fluidServedBytes_, (long)sduSize);
+            continue;
+        }
+
         // send the request message to the upper layer
         // TODO: Replace by tag
         auto pkt = new Packet("LteMacSduRequest");
@@ -330,12 +337,13 @@ void LteMacUe::macPduMake(MacCid cid)
     int64_t size = 0;
 
     macPduList_.clear();
+    macPduHeaders_.clear();
 
     //  Build a MAC pdu for each scheduled user on each codeword
     LteMacScheduleList::const_iterator it;
     for (it = scheduleList_->begin(); it != scheduleList_->end(); it++)
     {
-        Packet *macPkt = nullptr;
+        Ptr<LteMacPdu> header = nullptr;
 
         MacCid destCid = it->first.first;
         Codeword cw = it->first.second;
@@ -346,7 +354,7 @@ void LteMacUe::macPduMake(MacCid cid)
         std::pair<MacNodeId, Codeword> pktId = std::pair<MacNodeId, Codeword>(destId, cw);
         unsigned int sduPerCid = it->second;
 
-        MacPduList::iterator pit = macPduList_.find(pktId);
+        MacPduHeaderList::iterator hit = macPduHeaders_.find(pktId);
 
         if (sduPerCid == 0 && !bsrTriggered_)
         {
@@ -354,27 +362,34 @@ void LteMacUe::macPduMake(MacCid cid)
         }
 
         // No packets for this user on this codeword
-        if (pit == macPduList_.end())
+        if (hit == macPduHeaders_.end())
         {
-            macPkt = new Packet("LteMacPdu");
-            auto header = makeShared<LteMacPdu>();
+            auto macPkt = new Packet("LteMacPdu");
+
+            // the header is inserted into the packet once all SDUs and CEs have been attached
+            header = makeShared<LteMacPdu>();
             header->setHeaderLength(MAC_HEADER);
-            macPkt->insertAtFront(header);
 
-            macPkt->addTagIfAbsent<UserControlInfo>()->setSourceId(getMacNodeId());
-            macPkt->addTagIfAbsent<UserControlInfo>()->setDestId(destId);
-            macPkt->addTagIfAbsent<UserControlInfo>()->setDirection(UL);
-            macPkt->addTagIfAbsent<UserControlInfo>()->setUserTxParams(schedulingGrant_->getUserTxParams()->dup());
+            auto uinfo = macPkt->addTag<UserControlInfo>();
+            uinfo->setSourceId(getMacNodeId());
+            uinfo->setDestId(destId);
+            uinfo->setDirection(UL);
+            uinfo->setUserTxParams(schedulingGrant_->getUserTxParams()->dup());
 
             //macPkt->setControlInfo(uinfo);
             macPkt->setTimestamp(NOW);
             macPduList_[pktId] = macPkt;
+            macPduHeaders_[pktId] = header;
         }
         else
         {
-            macPkt = pit->second;
+            header = hit->second;
         }
 
+        // fluid connections have no SDUs: the PDU is sent anyway, carrying the BSR (if any)
+        if (isFluidConnection(destCid))
+            sduPerCid = 0;
+
         while (sduPerCid > 0)
         {
             // Add SDU to PDU
@@ -389,9 +404,7 @@ void LteMacUe::macPduMake(MacCid cid)
             auto pkt = check_and_cast<Packet *>(mbuf_[destCid]->popFront());
             drop(pkt);
 
-            auto header = macPkt->removeAtFront<LteMacPdu>();
             header->pushSdu(pkt);
-            macPkt->insertAtFront(header);
             sduPerCid--;
         }
         // consider virtual buffers to compute BSR size
@@ -497,7 +510,7 @@ void LteMacUe::macPduMake(MacCid cid)
         //
         //        }
 
-        auto header = macPkt->removeAtFront<LteMacPdu>();
+        auto header = macPduHeaders_[pit->first];
         if (bsrTriggered_)
         {
             MacBsr* bsr = new MacBsr();
@@ -528,16 +541,23 @@ void LteMacUe::macPduMake(MacCid cid)
             txBuf->insertPdu(txList.first,cw, macPkt);
         }
     }
+    macPduHeaders_.clear();
 }
 
 void LteMacUe::macPduUnmake(cPacket* pktAux)
 {
     auto pkt = check_and_cast<Packet *>(pktAux);
-    auto macPkt = pkt->removeAtFront<LteMacPdu>();
-    while (macPkt->hasSdu())
+
+    // the received PDU may share its content with the copy held by the sender's H-ARQ process,
+    // hence SDUs are read through a view rather than removing the (copied) header
+    auto macPkt = pkt->peekAtFront<LteMacPdu>();
+
+    std::vector<Packet*> sdus;
+    macPkt->dupSdus(sdus);
+    for (unsigned int i = 0; i < sdus.size(); ++i)
     {
         // Extract and send SDU
-        auto upPkt = macPkt->popSdu();
+        auto upPkt = sdus[i];
         take(upPkt);
 
         EV << "LteMacBase: pduUnmaker extracted SDU" << endl;
@@ -555,8 +575,6 @@ void LteMacUe::macPduUnmake(cPacket* pktAux)
         sendUpperPackets(upPkt);
     }
 
-    pkt->insertAtFront(macPkt);
-
     ASSERT(pkt->getOwner() == this);
     delete pkt;
 }
@@ -927,9 +945,15 @@ LteMacUe::updateUserTxParam(cPacket* pktAux)
 void LteMacUe::flushHarqBuffers()
 {
     // send the selected units to lower layers
-    HarqTxBuffers::iterator it2;
-    for(it2 = harqTxBuffers_.begin(); it2 != harqTxBuffers_.end(); it2++)
-        it2->second->sendSelectedDown();
+    // (only visit the buffers having a process selected for transmission)
+    harqTxSelectedIds_.clear();
+    harqTxSelected_.getKeys(harqTxSelectedIds_);
+    for (unsigned int i = 0; i < harqTxSelectedIds_.size(); i++)
+    {
+        HarqTxBuffers::iterator it = harqTxBuffers_.find(harqTxSelectedIds_[i]);
+        if (it != harqTxBuffers_.end())
+            it->second->sendSelectedDown();
+    }
 
     // deleting non-periodic grant
     if (schedulingGrant_ != nullptr && !schedulingGrant_->getPeriodic())
@@ -1024,4 +1048,5 @@ void LteMacUe::deleteQueues(MacNodeId nodeId)
     // remove traffic descriptor and lcg entry
     lcgMap_.clear();
     connDesc_.clear();
+    fluidConnections_.clear();
 }
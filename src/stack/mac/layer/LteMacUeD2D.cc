@@ -90,6 +90,7 @@ void LteMacUeD2D::macPduMake(MacCid cid)
     int64_t size = 0;
 
     macPduList_.clear();
+    macPduHeaders_.clear();
 
     bool bsrAlreadyMade = false;
     // UE is in D2D-mode but it received an UL grant (for BSR)
@@ -170,6 +171,7 @@ void LteMacUeD2D::macPduMake(MacCid cid)
             unsigned int sduPerCid = it->second;
 
             MacPduList::iterator pit = macPduList_.find(pktId);
+            Ptr<LteMacPdu> header = nullptr;
 
             if (sduPerCid == 0 && !bsrTriggered_ && !bsrD2DMulticastTriggered_)
             {
@@ -182,30 +184,36 @@ void LteMacUeD2D::macPduMake(MacCid cid)
                 // Always goes here because of the macPduList_.clear() at the beginning
                 // Build the Control Element of the MAC PDU
 
-                // Create a PDU
+                // Create a PDU. The header is inserted into the packet once all SDUs and CEs have been attached
                 macPkt = new Packet("LteMacPdu");
-                auto header = makeShared<LteMacPdu>();
+                header = makeShared<LteMacPdu>();
                 header->setHeaderLength(MAC_HEADER);
-                macPkt->insertAtFront(header);
-                macPkt->addTagIfAbsent<UserControlInfo>()->setSourceId(getMacNodeId());
-                macPkt->addTagIfAbsent<UserControlInfo>()->setDestId(destId);
-                macPkt->addTagIfAbsent<UserControlInfo>()->setLcid(MacCidToLcid(destCid));
-                macPkt->addTagIfAbsent<UserControlInfo>()->setDirection(dir);
-                macPkt->addTagIfAbsent<UserControlInfo>()->setLcid(MacCidToLcid(SHORT_BSR));
+                auto uinfo = macPkt->addTag<UserControlInfo>();
+                uinfo->setSourceId(getMacNodeId());
+                uinfo->setDestId(destId);
+                uinfo->setLcid(MacCidToLcid(destCid));
+                uinfo->setDirection(dir);
+                uinfo->setLcid(MacCidToLcid(SHORT_BSR));
                 if (usePreconfiguredTxParams_)
-                    macPkt->addTagIfAbsent<UserControlInfo>()->setUserTxParams(preconfiguredTxParams_->dup());
+                    uinfo->setUserTxParams(preconfiguredTxParams_->dup());
                 else
-                    macPkt->addTagIfAbsent<UserControlInfo>()->setUserTxParams(schedulingGrant_->getUserTxParams()->dup());
+                    uinfo->setUserTxParams(schedulingGrant_->getUserTxParams()->dup());
 
                 macPkt->setTimestamp(NOW);
                 macPduList_[pktId] = macPkt;
+                macPduHeaders_[pktId] = header;
             }
             else
             {
                 // Never goes here because of the macPduList_.clear() at the beginning
                 macPkt = pit->second;
+                header = macPduHeaders_[pktId];
             }
 
+            // fluid connections have no SDUs: the PDU is sent anyway, carrying the BSR (if any)
+            if (isFluidConnection(destCid))
+                sduPerCid = 0;
+
             while (sduPerCid > 0)
             {
                 // Add SDU to PDU
@@ -231,9 +239,7 @@ void LteMacUeD2D::macPduMake(MacCid cid)
 
                 drop(pkt);
 
-                auto header = macPkt->removeAtFront<LteMacPdu>();
                 header->pushSdu(pkt);
-                macPkt->insertAtFront(header);
                 sduPerCid--;
             }
 
@@ -358,7 +364,14 @@ void LteMacUeD2D::macPduMake(MacCid cid)
         //
         //        } */
 
-        auto header = macPkt->removeAtFront<LteMacPdu>();
+        // the header of a BSR-only PDU has already been inserted into the packet by makeBsr()
+        Ptr<LteMacPdu> header = nullptr;
+        MacPduHeaderList::iterator hit = macPduHeaders_.find(pit->first);
+        if (hit != macPduHeaders_.end())
+            header = hit->second;
+        else
+            header = macPkt->removeAtFront<LteMacPdu>();
+
         // Attach BSR to PDU if RAC is won and wasn't already made
         if ((bsrTriggered_ || bsrD2DMulticastTriggered_) && !bsrAlreadyMade )
         {
@@ -389,6 +402,7 @@ void LteMacUeD2D::macPduMake(MacCid cid)
             txBuf->insertPdu(txList.first,cw, macPkt);
         }
     }
+    macPduHeaders_.clear();
 }
 
 void LteMacUeD2D::handleMessage(cMessage* msg)
@@ -229,6 +229,21 @@ class SIMULTE_API LteMacPdu : public LteMacPdu_Base
         return pkt;
     }
 
+    /**
+     * dupSdus() appends to the given vector a copy of each SDU
+     * inside the sdu list, leaving the list untouched.
+     * The copies share the data chunks of the original SDUs,
+     * hence this can be used on a received (shared) PDU
+     * without duplicating the whole MAC PDU
+     *
+     * @param sdus vector where the copies are appended
+     */
+    virtual void dupSdus(std::vector<Packet*>& sdus) const
+    {
+        for (cPacketQueue::Iterator iter(*sduList_); !iter.end(); iter++)
+            sdus.push_back(check_and_cast<Packet *>(*iter)->dup());
+    }
+
     /**
      * hasSdu() verifies if there are other
      * SDUs inside the sdu list
@@ -275,6 +290,14 @@ class SIMULTE_API LteMacPdu : public LteMacPdu_Base
         return (!ceList_.empty());
     }
 
+    /**
+     * getCeList() gives readonly access to the MAC CE list
+     */
+    const MacControlElementsList& getCeList() const
+    {
+        return ceList_;
+    }
+
     long getId() const
     {
         return macPduId_;
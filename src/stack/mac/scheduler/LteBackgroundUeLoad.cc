@@ -0,0 +1,190 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "stack/mac/scheduler/LteBackgroundUeLoad.h"
+#include "stack/mac/scheduler/LteSchedulerEnb.h"
+#include "stack/mac/allocator/LteAllocationModule.h"
+#include "stack/mac/layer/LteMacEnb.h"
+#include "stack/mac/amc/LteAmc.h"
+#include "corenetwork/lteCellInfo/LteCellInfo.h"
+
+using namespace omnetpp;
+
+LteBackgroundUeLoad::LteBackgroundUeLoad(LteSchedulerEnb* scheduler, Direction dir, unsigned int numUes)
+{
+    scheduler_ = scheduler;
+    direction_ = dir;
+    ues_.resize(numUes);
+
+    LteMacEnb* mac = scheduler_->mac_;
+    std::string suffix = (direction_ == DL) ? "Dl" : "Ul";
+    cqiPar_ = &mac->par(("backgroundUeCqi" + suffix).c_str());
+    interarrivalTimePar_ = &mac->par(("backgroundUeInterarrivalTime" + suffix).c_str());
+    packetSizePar_ = &mac->par(("backgroundUePacketSize" + suffix).c_str());
+    cqiPeriod_ = mac->par("backgroundUeCqiPeriod").intValue() * TTI;
+
+    // schedule the first packet of each UE
+    for (unsigned int i = 0; i < numUes; i++)
+    {
+        simtime_t interarrivalTime = interarrivalTimePar_->doubleValue();
+        if (interarrivalTime > 0)
+            arrivals_.push(Arrival(NOW + interarrivalTime, i));
+    }
+
+    servedBytes_ = 0;
+    allocatedBlocks_ = 0;
+
+    throughput_ = mac->registerSignal(("backgroundUeThroughput" + suffix).c_str());
+    occupancy_ = mac->registerSignal(("backgroundUeOccupancy" + suffix).c_str());
+    backloggedUes_ = mac->registerSignal(("backgroundUeBacklogged" + suffix).c_str());
+
+    EV << "LteBackgroundUeLoad - " << numUes << " background UEs in " << dirToA(direction_) << ", "
+       << arrivals_.size() << " generating traffic" << endl;
+}
+
+void LteBackgroundUeLoad::scheduleFairShare(unsigned int numActiveConnections)
+{
+    servedBytes_ = 0;
+    allocatedBlocks_ = 0;
+
+    processArrivals();
+    if (backlogged_.empty())
+        return;
+
+    unsigned int share = availableBlocks() * backlogged_.size() / (backlogged_.size() + numActiveConnections);
+
+    EV << "LteBackgroundUeLoad::scheduleFairShare - " << backlogged_.size() << " backlogged background UEs, "
+       << numActiveConnections << " active connections, share " << share << " blocks" << endl;
+
+    serve(share);
+}
+
+void LteBackgroundUeLoad::scheduleLeftover()
+{
+    if (!backlogged_.empty())
+        serve(availableBlocks());
+
+    EV << "LteBackgroundUeLoad::scheduleLeftover - served " << servedBytes_ << " bytes on " << allocatedBlocks_ << " blocks" << endl;
+
+    LteMacEnb* mac = scheduler_->mac_;
+    mac->emit(throughput_, servedBytes_ / TTI);
+    if (scheduler_->resourceBlocks_ > 0)
+        mac->emit(occupancy_, (double)allocatedBlocks_ / scheduler_->resourceBlocks_);
+    mac->emit(backloggedUes_, (long)backlogged_.size());
+}
+
+void LteBackgroundUeLoad::processArrivals()
+{
+    while (!arrivals_.empty() && arrivals_.top().first <= NOW)
+    {
+        Arrival arrival = arrivals_.top();
+        arrivals_.pop();
+
+        BackgroundUe& ue = ues_[arrival.second];
+        int size = packetSizePar_->intValue();
+        if (size > 0)
+        {
+            if (ue.queue == 0)
+                backlogged_.push_back(arrival.second);
+            ue.queue += size;
+        }
+
+        simtime_t interarrivalTime = interarrivalTimePar_->doubleValue();
+        if (interarrivalTime > 0)
+            arrivals_.push(Arrival(arrival.first + interarrivalTime, arrival.second));
+    }
+}
+
+unsigned int LteBackgroundUeLoad::serve(unsigned int maxBlocks)
+{
+    LteAmc* amc = scheduler_->mac_->getAmc();
+
+    unsigned int used = 0;
+    unsigned int count = backlogged_.size();
+    for (unsigned int i = 0; i < count && used < maxBlocks; i++)
+    {
+        unsigned int index = backlogged_.front();
+        backlogged_.pop_front();
+        BackgroundUe& ue = ues_[index];
+
+        if (NOW >= ue.cqiExpiry)
+        {
+            int cqi = cqiPar_->intValue();
+            if (cqi < 0 || cqi > 15)
+                throw cRuntimeError("LteBackgroundUeLoad::serve - invalid CQI %d", cqi);
+            ue.cqi = cqi;
+            ue.cqiExpiry = NOW + cqiPeriod_;
+        }
+
+        // CQI equal to zero: the UE is out of range
+        if (ue.cqi == 0)
+        {
+            backlogged_.push_back(index);
+            continue;
+        }
+
+        // bytesGain() returns 111 if the queue does not fit in 110 blocks
+        unsigned int blocks = amc->bytesGain(ue.cqi, 1, ue.queue + MAC_HEADER + RLC_HEADER_UM, direction_);
+        if (blocks > maxBlocks - used)
+            blocks = maxBlocks - used;
+        blocks = bookBlocks(blocks, ue.cqi);
+        if (blocks == 0)
+        {
+            // no space left
+            backlogged_.push_front(index);
+            break;
+        }
+        used += blocks;
+
+        unsigned int bytes = amc->blockGain(ue.cqi, 1, blocks, direction_);
+        bytes = (bytes > MAC_HEADER + RLC_HEADER_UM) ? bytes - (MAC_HEADER + RLC_HEADER_UM) : 0;
+        if (bytes >= ue.queue)
+        {
+            servedBytes_ += ue.queue;
+            ue.queue = 0;
+        }
+        else
+        {
+            servedBytes_ += bytes;
+            ue.queue -= bytes;
+            backlogged_.push_back(index);
+        }
+    }
+    allocatedBlocks_ += used;
+    return used;
+}
+
+unsigned int LteBackgroundUeLoad::bookBlocks(unsigned int blocks, Cqi cqi)
+{
+    LteAllocationModule* allocator = scheduler_->allocator_;
+    LteAmc* amc = scheduler_->mac_->getAmc();
+    int numBands = scheduler_->mac_->getCellInfo()->getNumBands();
+
+    unsigned int booked = 0;
+    for (int b = numBands - 1; b >= 0 && booked < blocks; b--)
+    {
+        unsigned int n = allocator->availableBlocks(BACKGROUND_UE_ID, MACRO, b);
+        if (n > blocks - booked)
+            n = blocks - booked;
+        if (n > 0 && allocator->addBlocks(MACRO, b, BACKGROUND_UE_ID, n, amc->blockGain(cqi, 1, n, direction_)))
+            booked += n;
+    }
+    return booked;
+}
+
+unsigned int LteBackgroundUeLoad::availableBlocks()
+{
+    LteAllocationModule* allocator = scheduler_->allocator_;
+    int numBands = scheduler_->mac_->getCellInfo()->getNumBands();
+
+    unsigned int available = 0;
+    for (Band b = 0; b < numBands; b++)
+        available += allocator->availableBlocks(BACKGROUND_UE_ID, MACRO, b);
+    return available;
+}
@@ -0,0 +1,128 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTEBACKGROUNDUELOAD_H_
+#define _LTE_LTEBACKGROUNDUELOAD_H_
+
+#include <deque>
+#include <queue>
+#include "common/LteCommon.h"
+
+/// forward declarations
+class LteSchedulerEnb;
+
+/**
+ * @class LteBackgroundUeLoad
+ *
+ * Statistical model of the background UEs of a cell, for one direction.
+ *
+ * Each background UE is a virtual UE, with a CQI drawn from a distribution
+ * and a queue fed by a synthetic traffic process: it has no modules,
+ * packets or air frames. At each TTI, the backlogged background UEs take
+ * their fair share of the blocks left by retransmissions, as if they were
+ * as many active connections of the scheduler, then the blocks left unused
+ * by the actual UEs. The blocks are booked on the allocator under
+ * BACKGROUND_UE_ID, so that they are seen by the band status used for
+ * interference computation, and by the cell utilization statistics.
+ * Background UEs are served in round robin order, without HARQ errors
+ */
+class SIMULTE_API LteBackgroundUeLoad
+{
+  protected:
+
+    struct BackgroundUe
+    {
+        unsigned int queue;            // backlogged bytes
+        Cqi cqi;
+        omnetpp::simtime_t cqiExpiry;  // the CQI is drawn again after this time
+
+        BackgroundUe() : queue(0), cqi(0), cqiExpiry(0) {}
+    };
+
+    // next packet arrival time and index of the UE
+    typedef std::pair<omnetpp::simtime_t, unsigned int> Arrival;
+
+    // Owner scheduler
+    LteSchedulerEnb* scheduler_;
+
+    // Operational Direction
+    Direction direction_;
+
+    std::vector<BackgroundUe> ues_;
+
+    // indices of the backlogged UEs, in round robin order
+    std::deque<unsigned int> backlogged_;
+
+    // next packet arrival of each UE generating traffic, earliest first
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival> > arrivals_;
+
+    // distributions, evaluated by the MAC module
+    omnetpp::cPar* cqiPar_;
+    omnetpp::cPar* interarrivalTimePar_;
+    omnetpp::cPar* packetSizePar_;
+    omnetpp::simtime_t cqiPeriod_;
+
+    // bytes served and blocks used in the current TTI
+    unsigned int servedBytes_;
+    unsigned int allocatedBlocks_;
+
+    /// Statistics
+    omnetpp::simsignal_t throughput_;
+    omnetpp::simsignal_t occupancy_;
+    omnetpp::simsignal_t backloggedUes_;
+
+    /**
+     * Moves to the UE queues the packets arrived up to now
+     */
+    void processArrivals();
+
+    /**
+     * Serves the backlogged UEs in round robin order, using at most the
+     * given number of blocks.
+     * @return the number of blocks used
+     */
+    unsigned int serve(unsigned int maxBlocks);
+
+    /**
+     * Books the given number of blocks on the allocator for a UE with the given CQI,
+     * starting from the last band.
+     * @return the number of blocks actually booked
+     */
+    unsigned int bookBlocks(unsigned int blocks, Cqi cqi);
+
+    /**
+     * Returns the number of blocks still available on all bands
+     */
+    unsigned int availableBlocks();
+
+  public:
+
+    /**
+     * Creates the UEs, reading the parameters of the MAC of the scheduler.
+     * @param scheduler owner scheduler
+     * @param dir link direction
+     * @param numUes number of background UEs
+     */
+    LteBackgroundUeLoad(LteSchedulerEnb* scheduler, Direction dir, unsigned int numUes);
+
+    /**
+     * Called at each TTI after retransmissions, before the actual UEs are scheduled:
+     * the backlogged UEs take their fair share of the available blocks.
+     * @param numActiveConnections connections of the actual UEs that will compete for the blocks
+     */
+    void scheduleFairShare(unsigned int numActiveConnections);
+
+    /**
+     * Called at each TTI after the actual UEs are scheduled: the backlogged UEs
+     * take the blocks left, and statistics are recorded
+     */
+    void scheduleLeftover();
+};
+
+#endif // _LTE_LTEBACKGROUNDUELOAD_H_
@@ -11,6 +11,7 @@
 #include "stack/mac/allocator/LteAllocationModule.h"
 #include "stack/mac/allocator/LteAllocationModuleFrequencyReuse.h"
 #include "stack/mac/scheduler/LteScheduler.h"
+#include "stack/mac/scheduler/LteBackgroundUeLoad.h"
 #include "stack/mac/scheduling_modules/LteDrr.h"
 #include "stack/mac/scheduling_modules/LteMaxCi.h"
 #include "stack/mac/scheduling_modules/LtePf.h"
@@ -29,6 +30,7 @@ LteSchedulerEnb::LteSchedulerEnb()
     mac_ = 0;
     allocator_ = 0;
     scheduler_ = 0;
+    backgroundUes_ = nullptr;
     vbuf_ = 0;
     harqTxBuffers_ = 0;
     harqRxBuffers_ = 0;
@@ -40,6 +42,7 @@ LteSchedulerEnb::~LteSchedulerEnb()
     delete allocator_;
     if(scheduler_)
         delete scheduler_;
+    delete backgroundUes_;
 }
 
 void LteSchedulerEnb::initialize(Direction dir, LteMacEnb* mac)
@@ -67,6 +70,15 @@ void LteSchedulerEnb::initialize(Direction dir, LteMacEnb* mac)
     else
         allocator_ = new LteAllocationModule(mac_, direction_);
 
+    // Create background UEs
+    int numBackgroundUes = mac_->par("numBackgroundUes");
+    if (numBackgroundUes > 0)
+    {
+        if (discipline == ALLOCATOR_BESTFIT)
+            throw cRuntimeError("LteSchedulerEnb::initialize - background UEs are not supported by the ALLOCATOR_BESTFIT discipline");
+        backgroundUes_ = new LteBackgroundUeLoad(this, direction_, numBackgroundUes);
+    }
+
     // Initialize statistics
     cellBlocksUtilizationDl_ = mac_->registerSignal("cellBlocksUtilizationDl");
     cellBlocksUtilizationUl_ = mac_->registerSignal("cellBlocksUtilizationUl");
@@ -81,6 +93,7 @@ LteMacScheduleList* LteSchedulerEnb::schedule()
     // clearing structures for new scheduling
     scheduleList_.clear();
     allocatedCws_.clear();
+    grantedBytes_.clear();
 
     // clean the allocator
     initAndResetAllocator();
@@ -89,7 +102,13 @@ LteMacScheduleList* LteSchedulerEnb::schedule()
 
     // scheduling of retransmission and transmission
     EV << "___________________________start RTX __________________________________" << endl;
-    if(!(scheduler_->scheduleRetransmissions()))
+    bool spaceEnded = scheduler_->scheduleRetransmissions();
+
+    // background UEs take their share of the space left by retransmissions
+    if (backgroundUes_ != nullptr)
+        backgroundUes_->scheduleFairShare(spaceEnded ? 0 : scheduler_->readActiveSet().size());
+
+    if(!spaceEnded)
     {
         EV << "____________________________ end RTX __________________________________" << endl;
         EV << "___________________________start SCHED ________________________________" << endl;
@@ -98,6 +117,10 @@ LteMacScheduleList* LteSchedulerEnb::schedule()
         EV << "____________________________ end SCHED ________________________________" << endl;
     }
 
+    // background UEs take the space left by the other UEs
+    if (backgroundUes_ != nullptr)
+        backgroundUes_->scheduleLeftover();
+
     // record assigned resource blocks statistics
     resourceBlockStatistics();
 
@@ -397,6 +420,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
 
         // number of bytes to be consumed from the virtual buffer
         unsigned int consumedBytes = cwAllocatedBytes - (MAC_HEADER + RLC_HEADER_UM);  // TODO RLC may be either UM or AM
+        unsigned int drainedBytes = conn->getQueueOccupancy();
         while (!conn->isEmpty() && consumedBytes > 0)
         {
             unsigned int vPktSize = conn->front().first;
@@ -418,6 +442,8 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
             }
         }
 
+        drainedBytes -= conn->getQueueOccupancy();
+
         EV << "LteSchedulerEnb::grant Codeword allocation: " << cwAllocatedBytes << "bytes" << endl;
         if (cwAllocatedBytes > 0)
         {
@@ -437,6 +463,7 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
             // if direction is DL , then schedule list contains number of to-be-trasmitted SDUs ,
             // otherwise it contains number of granted blocks
             scheduleList_[scListId] += ((dir == DL) ? vQueueItemCounter : cwAllocatedBlocks);
+            grantedBytes_[scListId] += drainedBytes;
 
             EV << "LteSchedulerEnb::grant CODEWORD IS NOW BUSY: GO TO NEXT CODEWORD." << endl;
             if (allocatedCws_.at(nodeId) == MAX_CODEWORDS)
@@ -461,6 +488,12 @@ unsigned int LteSchedulerEnb::scheduleGrant(MacCid cid, unsigned int bytes, bool
     return totalAllocatedBytes;
 }
 
+unsigned int LteSchedulerEnb::getGrantedBytes(MacCid cid, Codeword cw)
+{
+    LteMacScheduleList::iterator it = grantedBytes_.find(std::make_pair(cid, cw));
+    return (it != grantedBytes_.end()) ? it->second : 0;
+}
+
 void LteSchedulerEnb::update()
 {
     scheduler_->updateSchedulingInfo();
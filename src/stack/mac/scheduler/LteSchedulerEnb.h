@@ -18,6 +18,7 @@
 class LteScheduler;
 class LteAllocationModule;
 class LteMacEnb;
+class LteBackgroundUeLoad;
 
 /**
  * @class LteSchedulerEnb
@@ -38,6 +39,7 @@ class SIMULTE_API LteSchedulerEnb
     friend class LteMaxCiOptMB;
     friend class LteMaxCiComp;
     friend class LteAllocatorBestFit;
+    friend class LteBackgroundUeLoad;
 
   protected:
 
@@ -77,6 +79,9 @@ class SIMULTE_API LteSchedulerEnb
     // Scheduling agent.
     LteScheduler *scheduler_;
 
+    // Background UEs competing for the blocks (nullptr if there are none)
+    LteBackgroundUeLoad *backgroundUes_;
+
     // Operational Direction. Set via initialize().
     Direction direction_;
 
@@ -86,6 +91,9 @@ class SIMULTE_API LteSchedulerEnb
     // Codeword list
     LteMacAllocatedCws allocatedCws_;
 
+    // Bytes drained from the virtual buffers by scheduleGrant(), for each entry of the schedule list
+    LteMacScheduleList grantedBytes_;
+
     // Pointer to downlink virtual buffers (that are in LteMacBase)
     LteMacBufferMap* vbuf_;
 
@@ -232,6 +240,12 @@ class SIMULTE_API LteSchedulerEnb
     virtual unsigned int scheduleGrant(MacCid cid, unsigned int bytes, bool& terminate, bool& active, bool& eligible,
         std::vector<BandLimit>* bandLim = nullptr, Remote antenna = MACRO, bool limitBl = false);
 
+    /**
+     * Returns the bytes drained from the virtual buffer of a connection
+     * on the given codeword by the last scheduling round
+     */
+    unsigned int getGrantedBytes(MacCid cid, Codeword cw);
+
     /*
      * Getter for active connection set
      */
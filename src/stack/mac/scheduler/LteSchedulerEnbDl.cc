@@ -270,26 +270,23 @@ LteSchedulerEnbDl::rtxschedule()
     // retrieving reference to HARQ entities
     HarqTxBuffers* harqQueues = mac_->getHarqTxBuffers();
 
-    HarqTxBuffers::iterator it = harqQueues->begin();
-    HarqTxBuffers::iterator et = harqQueues->end();
+    // only the buffers having units ready for retransmission need to be examined
+    // (the buffers of the UEs that left the simulation are deleted on their unregistration)
+    readyIds_.clear();
+    mac_->getHarqTxReady().getKeys(readyIds_);
 
     std::vector<BandLimit> usableBands;
 
     // examination of HARQ process in rtx status, adding them to scheduling list
-    for(; it != et; ++it)
+    for (unsigned int i = 0; i < readyIds_.size(); ++i)
     {
         // For each UE
-        MacNodeId nodeId = it->first;
+        MacNodeId nodeId = readyIds_[i];
+
+        HarqTxBuffers::iterator it = harqQueues->find(nodeId);
+        if (it == harqQueues->end())
+            continue;
 
-        OmnetId id = binder_->getOmnetId(nodeId);
-        if(id == 0){
-            // UE has left the simulation, erase HARQ-queue
-            it = harqQueues->erase(it);
-            if(it == et)
-                break;
-            else
-                continue;
-        }
         LteHarqBufferTx* currHarq = it->second;
         std::vector<LteHarqProcessTx *> * processes = currHarq->getHarqProcesses();
 
@@ -27,6 +27,9 @@ class SIMULTE_API LteSchedulerEnbDl : public LteSchedulerEnb
 
   protected:
 
+    /// Node ids of the H-ARQ buffers with units ready for retransmission, reused at every TTI
+    std::vector<MacNodeId> readyIds_;
+
     //---------------------------------------------
 
     /**
@@ -25,12 +25,12 @@ LteSchedulerEnbUl::checkEligibility(MacNodeId id, Codeword& cw)
 
         // get current Harq Process for nodeId
         unsigned char currentAcid = harqStatus_.at(id);
-        // get current Harq Process status
-        std::vector<RxUnitStatus> status = ulHarq->getProcess(currentAcid)->getProcessStatus();
+        // get current Harq Process
+        LteHarqProcessRx* currentProcess = ulHarq->getProcess(currentAcid);
         // check if at least one codeword buffer is available for reception
         for (; cw < MAX_CODEWORDS; ++cw)
         {
-            if (status.at(cw).second == RXHARQ_PDU_EMPTY)
+            if (currentProcess->getUnitStatus(cw) == RXHARQ_PDU_EMPTY)
             {
                 return true;
             }
@@ -140,42 +140,27 @@ LteSchedulerEnbUl::rtxschedule()
         EV << NOW << " LteSchedulerEnbUl::rtxschedule eNodeB: " << mac_->getMacCellId() << endl;
         EV << NOW << " LteSchedulerEnbUl::rtxschedule Direction: " << (direction_ == UL ? "UL" : "DL") << endl;
 
-        HarqRxBuffers::iterator it= harqRxBuffers_->begin() , et=harqRxBuffers_->end();
+        // only the buffers having corrupted units need to be examined
+        // (the units of the UEs that left the simulation are purged on their unregistration)
+        corruptedIds_.clear();
+        mac_->getHarqRxCorrupted().getKeys(corruptedIds_);
 
-        for(; it != et; ++it)
+        for (unsigned int i = 0; i < corruptedIds_.size(); ++i)
         {
             // get current nodeId
-            MacNodeId nodeId = it->first;
+            MacNodeId nodeId = corruptedIds_[i];
 
-            if(nodeId == 0){
-                // UE has left the simulation - erase queue and continue
-                harqRxBuffers_->erase(nodeId);
+            HarqRxBuffers::iterator it = harqRxBuffers_->find(nodeId);
+            if (it == harqRxBuffers_->end())
                 continue;
-            }
-            OmnetId id = binder_->getOmnetId(nodeId);
-            if(id == 0){
-                harqRxBuffers_->erase(nodeId);
-                continue;
-            }
 
             // get current Harq Process for nodeId
             unsigned char currentAcid = harqStatus_.at(nodeId);
 
             // check whether the UE has a H-ARQ process waiting for retransmission. If not, skip UE.
-            bool skip = true;
             unsigned char acid = (currentAcid + 2) % (it->second->getProcesses());
             LteHarqProcessRx* currentProcess = it->second->getProcess(acid);
-            std::vector<RxUnitStatus> procStatus = currentProcess->getProcessStatus();
-            std::vector<RxUnitStatus>::iterator pit = procStatus.begin();
-            for (; pit != procStatus.end(); ++pit )
-            {
-                if (pit->second == RXHARQ_PDU_CORRUPTED)
-                {
-                    skip = false;
-                    break;
-                }
-            }
-            if (skip)
+            if (!currentProcess->hasCorruptedUnits())
                 continue;
 
             EV << NOW << "LteSchedulerEnbUl::rtxschedule UE: " << nodeId << "Acid: " << (unsigned int)currentAcid << endl;
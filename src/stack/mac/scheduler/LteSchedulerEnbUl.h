@@ -43,6 +43,9 @@ class SIMULTE_API LteSchedulerEnbUl : public LteSchedulerEnb
     //! RAC requests flags: signals wheter an UE shall be granted the RAC allocation
     RacStatus racStatus_;
 
+    //! Node ids of the H-ARQ rx buffers with corrupted units, reused at every TTI
+    std::vector<MacNodeId> corruptedIds_;
+
   public:
 
     //! Updates HARQ descriptor current process pointer (to be called every TTI by main loop).
@@ -65,36 +65,6 @@ void LteAllocatorBestFit::checkHole(Candidate& candidate, Band holeIndex, unsign
 
 }
 
-bool LteAllocatorBestFit::checkConflict(const CGMatrix* cgMatrix, MacNodeId nodeIdA, MacNodeId nodeIdB)
-{
-    bool conflict = false;
-
-    CGMatrix::const_iterator it = cgMatrix->begin(), et = cgMatrix->end();
-    for(; it != et; ++it)
-    {
-        if (it->first.srcId != nodeIdA)
-            continue;
-
-        std::map<CGVertex,bool>::const_iterator conf_it = it->second.begin(), conf_et = it->second.end();
-        for (; conf_it != conf_et; ++conf_it)
-        {
-            if (conf_it->first.srcId != nodeIdB)
-                continue;
-
-            if (conf_it->second)
-            {
-                conflict = true;
-                break;
-            }
-        }
-
-        if (conflict)
-            break;
-    }
-
-    return conflict;
-}
-
 void LteAllocatorBestFit::prepareSchedule()
 {
     EV << NOW << " LteAllocatorBestFit::schedule " << eNbScheduler_->mac_->getMacNodeId() << endl;
@@ -111,12 +81,10 @@ void LteAllocatorBestFit::prepareSchedule()
     bool reuseD2D = mac_->isReuseD2DEnabled();
     bool reuseD2DMulti = mac_->isReuseD2DMultiEnabled();
 
-    const CGMatrix* cgMatrix = nullptr;
     if (reuseD2D || reuseD2DMulti)
     {
         if (conflictGraph_ == nullptr)
             throw cRuntimeError("LteAllocatorBestFit::prepareSchedule - conflictGraph is a NULL pointer");
-        cgMatrix = conflictGraph_->getConflictGraph();
     }
 
     // Get the bands occupied by RAC and RTX
@@ -332,7 +300,7 @@ void LteAllocatorBestFit::prepareSchedule()
                 for ( ; it != et; ++it)
                 {
                     MacNodeId allocatedNodeId = *it;
-                    if (checkConflict(cgMatrix, nodeId, allocatedNodeId))
+                    if (conflictGraph_->checkConflict(nodeId, allocatedNodeId))
                     {
                         jump_band = true;
                         break;
@@ -61,9 +61,6 @@ class SIMULTE_API LteAllocatorBestFit : public virtual LteScheduler
     // returns the next "hole" in the subframe where the UEs can be eventually allocated
     void checkHole(Candidate& candidate, Band holeIndex, unsigned int holeLen, unsigned int req);
 
-    // returns true if the two nodes cannot transmit on the same block
-    bool checkConflict(const CGMatrix* cgMatrix, MacNodeId nodeIdA, MacNodeId nodeIdB);
-
   public:
 
     LteAllocatorBestFit();
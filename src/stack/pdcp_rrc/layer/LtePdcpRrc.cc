@@ -123,33 +123,80 @@ void LtePdcpRrcBase::headerDecompress(Packet* pkt)
 void LtePdcpRrcBase::setTrafficInformation(cPacket* pkt,
     inet::Ptr<FlowControlInfo> lteInfo)
 {
-    if ((strcmp(pkt->getName(), "VoIP")) == 0)
-    {
-        lteInfo->setApplication(VOIP);
-        lteInfo->setTraffic(CONVERSATIONAL);
-        lteInfo->setRlcType((int) par("conversationalRlc"));
-    }
-    else if ((strcmp(pkt->getName(), "gaming")) == 0)
+    PdcpFlowKey key = { lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), 0 };
+    PdcpTrafficInfo& info = trafficInfoCache_[key];
+
+    // classify the connection on its first packet, or if the packet name changes
+    if (info.pktName.empty() || info.pktName != pkt->getName())
     {
-        lteInfo->setApplication(GAMING);
-        lteInfo->setTraffic(INTERACTIVE);
-        lteInfo->setRlcType((int) par("interactiveRlc"));
+        info.pktName = pkt->getName();
+        if ((strcmp(pkt->getName(), "VoIP")) == 0)
+        {
+            info.application = VOIP;
+            info.traffic = CONVERSATIONAL;
+            info.rlcType = conversationalRlc_;
+        }
+        else if ((strcmp(pkt->getName(), "gaming")) == 0)
+        {
+            info.application = GAMING;
+            info.traffic = INTERACTIVE;
+            info.rlcType = interactiveRlc_;
+        }
+        else if ((strcmp(pkt->getName(), "VoDPacket") == 0)
+            || (strcmp(pkt->getName(), "VoDFinishPacket") == 0))
+        {
+            info.application = VOD;
+            info.traffic = STREAMING;
+            info.rlcType = streamingRlc_;
+        }
+        else
+        {
+            info.application = CBR;
+            info.traffic = BACKGROUND;
+            info.rlcType = backgroundRlc_;
+        }
     }
-    else if ((strcmp(pkt->getName(), "VoDPacket") == 0)
-        || (strcmp(pkt->getName(), "VoDFinishPacket") == 0))
+
+    lteInfo->setApplication(info.application);
+    lteInfo->setTraffic(info.traffic);
+    lteInfo->setRlcType(info.rlcType);
+    lteInfo->setDirection(getDirection());
+}
+
+LogicalCid LtePdcpRrcBase::lookupConnection(inet::Ptr<FlowControlInfo> lteInfo, bool perDirection, LtePdcpEntity*& entity)
+{
+    PdcpFlowKey key = { lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(),
+        (uint16_t)(perDirection ? lteInfo->getDirection() : 0) };
+
+    auto it = connectionCache_.find(key);
+    if (it != connectionCache_.end())
     {
-        lteInfo->setApplication(VOD);
-        lteInfo->setTraffic(STREAMING);
-        lteInfo->setRlcType((int) par("streamingRlc"));
+        entity = it->second.entity;
+        return it->second.lcid;
     }
-    else
+
+    // TODO: Since IP addresses can change when we add and remove nodes, maybe node IDs should be used instead of them
+    LogicalCid mylcid = perDirection ?
+        ht_->find_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), lteInfo->getDirection()) :
+        ht_->find_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService());
+    if (mylcid == 0xFFFF)
     {
-        lteInfo->setApplication(CBR);
-        lteInfo->setTraffic(BACKGROUND);
-        lteInfo->setRlcType((int) par("backgroundRlc"));
+        // LCID not found
+        mylcid = lcid_++;
+
+        EV << "LteRrc : Connection not found, new CID created with LCID " << mylcid << "\n";
+
+        if (perDirection)
+            ht_->create_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), lteInfo->getDirection(), mylcid);
+        else
+            ht_->create_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), mylcid);
     }
 
-    lteInfo->setDirection(getDirection());
+    entity = getEntity(mylcid);
+    PdcpConnectionInfo& info = connectionCache_[key];
+    info.lcid = mylcid;
+    info.entity = entity;
+    return mylcid;
 }
 
 /*
@@ -172,25 +219,13 @@ void LtePdcpRrcBase::fromDataPort(cPacket *pktAux)
     EV << "LteRrc : Received CID request for Traffic [ " << "Source: " << Ipv4Address(lteInfo->getSrcAddr())
        << " Destination: " << Ipv4Address(lteInfo->getDstAddr()) << " ToS: " << lteInfo->getTypeOfService() << " ]\n";
 
-    // TODO: Since IP addresses can change when we add and remove nodes, maybe node IDs should be used instead of them
-    LogicalCid mylcid;
-    if ((mylcid = ht_->find_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(),
-            lteInfo->getTypeOfService())) == 0xFFFF)
-    {
-        // LCID not found
-        mylcid = lcid_++;
-
-        EV << "LteRrc : Connection not found, new CID created with LCID " << mylcid << "\n";
-
-        ht_->create_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), mylcid);
-    }
+    // get the LCID and the PDCP entity of the connection
+    LtePdcpEntity* entity;
+    LogicalCid mylcid = lookupConnection(lteInfo, false, entity);
 
     EV << "LteRrc : Assigned Lcid: " << mylcid << "\n";
     EV << "LteRrc : Assigned Node ID: " << nodeId_ << "\n";
 
-    // get the PDCP entity for this LCID
-    LtePdcpEntity* entity = getEntity(mylcid);
-
     // get the sequence number for this PDCP SDU.
     // Note that the numbering depends on the entity the packet is associated to.
     unsigned int sno = entity->nextSequenceNumber();
@@ -329,6 +364,11 @@ void LtePdcpRrcBase::initialize(int stage)
             throw cRuntimeError("Size of compressed header must not be less than %i", MIN_COMPRESSED_HEADER_SIZE.get());
         }
 
+        conversationalRlc_ = par("conversationalRlc");
+        interactiveRlc_ = par("interactiveRlc");
+        streamingRlc_ = par("streamingRlc");
+        backgroundRlc_ = par("backgroundRlc");
+
         nodeId_ = getAncestorPar("macNodeId");
 
         // statistics
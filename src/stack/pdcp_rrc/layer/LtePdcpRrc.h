@@ -11,6 +11,7 @@
 #define _LTE_LTEPDCPRRC_H_
 
 #include <omnetpp.h>
+#include <unordered_map>
 
 #include "corenetwork/binder/LteBinder.h"
 #include "common/LteCommon.h"
@@ -142,8 +143,31 @@ class SIMULTE_API LtePdcpRrcBase : public omnetpp::cSimpleModule
      * @return Direction of traffic
      */
     virtual Direction getDirection() = 0;
+
+    /**
+     * setTrafficInformation() sets application, traffic class and
+     * RLC type of the packet, according to the packet name.
+     * The classification of each connection is cached, and computed
+     * again only if the packet name changes
+     *
+     * @param pkt packet
+     * @param lteInfo Control Info
+     */
     void setTrafficInformation(omnetpp::cPacket* pkt, inet::Ptr<FlowControlInfo> lteInfo);
 
+    /**
+     * lookupConnection() returns the LCID of the connection the packet
+     * belongs to, and its PDCP entity. A new LCID is assigned to
+     * unknown connections.
+     *
+     * @param lteInfo Control Info
+     * @param perDirection if true, different LCIDs are assigned to
+     *        different directions of the same connection
+     * @param entity filled with the PDCP entity of the connection
+     * @return LCID of the connection
+     */
+    LogicalCid lookupConnection(inet::Ptr<FlowControlInfo> lteInfo, bool perDirection, LtePdcpEntity*& entity);
+
     bool isCompressionEnabled();
 
     /*
@@ -219,6 +243,66 @@ class SIMULTE_API LtePdcpRrcBase : public omnetpp::cSimpleModule
     /// Hash Table used for CID <-> Connection mapping
     ConnectionsTable* ht_;
 
+    /// RLC type of each traffic class, read at initialization
+    int conversationalRlc_;
+    int interactiveRlc_;
+    int streamingRlc_;
+    int backgroundRlc_;
+
+    /**
+     * Key of the flow caches: the 4-tuple used for LCID assignment
+     */
+    struct PdcpFlowKey
+    {
+        uint32_t srcAddr;
+        uint32_t dstAddr;
+        uint16_t typeOfService;
+        uint16_t dir;
+
+        bool operator==(const PdcpFlowKey& other) const
+        {
+            return srcAddr == other.srcAddr && dstAddr == other.dstAddr &&
+                typeOfService == other.typeOfService && dir == other.dir;
+        }
+    };
+
+    struct PdcpFlowKeyHash
+    {
+        size_t operator()(const PdcpFlowKey& key) const
+        {
+            uint64_t addr = ((uint64_t)key.srcAddr << 32) | key.dstAddr;
+            uint64_t rest = ((uint64_t)key.typeOfService << 16) | key.dir;
+            return std::hash<uint64_t>()(addr ^ (rest * 0x9e3779b97f4a7c15ULL));
+        }
+    };
+
+    /**
+     * Traffic information of a connection, computed from
+     * the name of its packets
+     */
+    struct PdcpTrafficInfo
+    {
+        std::string pktName;
+        ApplicationType application;
+        LteTrafficClass traffic;
+        int rlcType;
+    };
+
+    /**
+     * LCID and PDCP entity assigned to a connection
+     */
+    struct PdcpConnectionInfo
+    {
+        LogicalCid lcid;
+        LtePdcpEntity* entity;
+    };
+
+    /// Traffic information cache (the direction is not part of the key)
+    std::unordered_map<PdcpFlowKey, PdcpTrafficInfo, PdcpFlowKeyHash> trafficInfoCache_;
+
+    /// LCID and PDCP entity cache
+    std::unordered_map<PdcpFlowKey, PdcpConnectionInfo, PdcpFlowKeyHash> connectionCache_;
+
     /// Identifier for this node
     MacNodeId nodeId_;
 
@@ -108,25 +108,12 @@ void LtePdcpRrcUeD2D::fromDataPort(cPacket *pktAux)
      * RLC layer will create different RLC entities for different LCIDs
      */
 
-    LogicalCid mylcid;
-    if ((mylcid = ht_->find_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), lteInfo->getDirection())) == 0xFFFF)
-    {
-        // LCID not found
-
-        // assign a new LCID to the connection
-        mylcid = lcid_++;
-
-        EV << "LtePdcpRrcUeD2D : Connection not found, new CID created with LCID " << mylcid << "\n";
-
-        ht_->create_entry(lteInfo->getSrcAddr(), lteInfo->getDstAddr(), lteInfo->getTypeOfService(), lteInfo->getDirection(), mylcid);
-    }
+    LtePdcpEntity* entity;
+    LogicalCid mylcid = lookupConnection(lteInfo, true, entity);
 
     EV << "LtePdcpRrcUeD2D : Assigned Lcid: " << mylcid << "\n";
     EV << "LtePdcpRrcUeD2D : Assigned Node ID: " << nodeId_ << "\n";
 
-    // get the PDCP entity for this LCID
-    LtePdcpEntity* entity = getEntity(mylcid);
-
     // get the sequence number for this PDCP SDU.
     // Note that the numbering depends on the entity the packet is associated to.
     unsigned int sno = entity->nextSequenceNumber();
@@ -17,6 +17,7 @@
 #include "stack/phy/layer/LtePhyBase.h"
 #include "stack/phy/packet/LteAirFrame.h"
 #include <omnetpp.h>
+#include <limits>
 
 class LteAirFrame;
 class LtePhyBase;
@@ -83,6 +84,16 @@ class SIMULTE_API LteChannelModel : public omnetpp::cSimpleModule
      * Compute Received useful signal for D2D transmissions
      */
     virtual std::vector<double> getRSRP_D2D(LteAirFrame *frame, UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord) = 0;
+    /*
+     * Compute the deterministic part of the received signal for D2D transmissions (i.e. without shadowing
+     * and fading, in the most favourable visibility conditions), without modifying the state of the channel.
+     * It is used to discard frames that cannot be captured before computing their RSRP.
+     * Returns +infinity if the channel model cannot estimate it
+     */
+    virtual double getMeanRSRP_D2D(UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord)
+    {
+        return std::numeric_limits<double>::infinity();
+    }
     /*
      * Compute sinr (D2D) for each band for user nodeId according to pathloss, shadowing (optional) and multipath fading
      *
@@ -72,6 +72,13 @@ class SIMULTE_API LteDummyChannelModel : public LteChannelModel
     * Compute Received useful signal for D2D transmissions
     */
    virtual std::vector<double> getRSRP_D2D(LteAirFrame *frame, UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord);
+   /*
+    * The received signal is constant
+    */
+   virtual double getMeanRSRP_D2D(UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord)
+   {
+       return 10000;
+   }
    /*
     * Compute FAKE sinr (D2D) for each band for user nodeId according to pathloss, shadowing (optional) and multipath fading
     *
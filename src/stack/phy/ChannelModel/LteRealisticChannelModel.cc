@@ -824,6 +824,27 @@ std::vector<double> LteRealisticChannelModel::getRSRP_D2D(LteAirFrame *frame, Us
    return rsrpVector;
 }
 
+double LteRealisticChannelModel::getMeanRSRP_D2D(UserControlInfo* lteInfo_1, MacNodeId destId, Coord destCoord)
+{
+   double distance = lteInfo_1->getCoord().distance(destCoord);
+
+   // path loss only, as in getAttenuation_D2D(). The visibility state of the transmitter
+   // may be drawn again when computing the actual attenuation, hence use the best one
+   double attenuation;
+   if (dynamicLos_)
+       attenuation = std::min(computePathLoss(distance, 0, true), computePathLoss(distance, 0, false));
+   else
+       attenuation = computePathLoss(distance, 0, fixedLos_);
+
+   double recvPower = lteInfo_1->getD2dTxPower() - attenuation; // (dBm-dB)=dBm
+   recvPower += 2 * antennaGainUe_;
+   recvPower -= cableLoss_;
+   if (lteInfo_1->getTxMode() == MULTI_USER)
+       recvPower -= 3;
+
+   return recvPower;
+}
+
 std::vector<double> LteRealisticChannelModel::getSINR_D2D(LteAirFrame *frame, UserControlInfo* lteInfo, MacNodeId destId, Coord destCoord, MacNodeId enbId)
 {
    // AttenuationVector::iterator it;
@@ -189,6 +189,10 @@ public:
    * Compute Received useful signal for D2D transmissions
    */
   virtual std::vector<double> getRSRP_D2D(LteAirFrame *frame, UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord);
+  /*
+   * Compute Received signal for D2D transmissions, without shadowing and fading
+   */
+  virtual double getMeanRSRP_D2D(UserControlInfo* lteInfo_1, MacNodeId destId, inet::Coord destCoord);
   /*
    * Compute sinr (D2D) for each band for user nodeId according to pathloss, shadowing (optional) and multipath fading
    *
@@ -0,0 +1,79 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include <algorithm>
+
+#include "stack/phy/feedback/LteLiteUeFeedbackDriver.h"
+#include "stack/phy/layer/LtePhyUe.h"
+
+Define_Module(LteLiteUeFeedbackDriver);
+
+using namespace omnetpp;
+
+LteLiteUeFeedbackDriver::LteLiteUeFeedbackDriver()
+{
+    fbTimer_ = nullptr;
+}
+
+LteLiteUeFeedbackDriver::~LteLiteUeFeedbackDriver()
+{
+    cancelAndDelete(fbTimer_);
+}
+
+void LteLiteUeFeedbackDriver::initialize()
+{
+    fbPeriod_ = (simtime_t)(int(par("fbPeriod")) * TTI);// TTI -> seconds
+    fbDelay_ = (simtime_t)(int(par("fbDelay")) * TTI);// TTI -> seconds
+    if (fbPeriod_ <= fbDelay_)
+    {
+        error("Feedback Period MUST be greater than Feedback Delay");
+    }
+
+    feedbackReq_.request = true;
+    feedbackReq_.genType = getFeedbackGeneratorType(par("feedbackGeneratorType").stringValue());
+    feedbackReq_.type = getFeedbackType(par("feedbackType").stringValue());
+    feedbackReq_.txMode = aToTxMode(par("initialTxMode"));
+    feedbackReq_.rbAllocationType = getRbAllocationType(par("rbAllocationType").stringValue());
+
+    fbTimer_ = new cMessage("liteUeFeedback");
+
+    WATCH(fbPeriod_);
+    WATCH(fbDelay_);
+}
+
+void LteLiteUeFeedbackDriver::handleMessage(cMessage *msg)
+{
+    EV << NOW << " LteLiteUeFeedbackDriver::handleMessage - periodic feedback of " << ues_.size() << " UEs" << endl;
+
+    // the feedback is empty, as that of the feedback generator: it is computed by the eNB
+    LteFeedbackDoubleVector fb;
+    for (unsigned int i = 0; i < ues_.size(); i++)
+        ues_[i]->sendFeedback(fb, fb, feedbackReq_);
+
+    if (!ues_.empty())
+        scheduleAt(NOW + fbPeriod_, fbTimer_);
+}
+
+void LteLiteUeFeedbackDriver::registerUe(LtePhyUe* phy)
+{
+    Enter_Method_Silent("registerUe");
+    ues_.push_back(phy);
+
+    // the first sensing is done now, as in the feedback generator
+    if (!fbTimer_->isScheduled())
+        scheduleAt(NOW + fbDelay_, fbTimer_);
+}
+
+void LteLiteUeFeedbackDriver::unregisterUe(LtePhyUe* phy)
+{
+    Enter_Method_Silent("unregisterUe");
+    std::vector<LtePhyUe*>::iterator it = std::find(ues_.begin(), ues_.end(), phy);
+    if (it != ues_.end())
+        ues_.erase(it);
+}
@@ -0,0 +1,69 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTELITEUEFEEDBACKDRIVER_H_
+#define _LTE_LTELITEUEFEEDBACKDRIVER_H_
+
+#include <omnetpp.h>
+#include "common/LteCommon.h"
+
+class LtePhyUe;
+
+/**
+ * @class LteLiteUeFeedbackDriver
+ * @brief Periodic feedback trigger for the lite UEs of a cell
+ *
+ * Replaces the LteDlFeedbackGenerator of each lite UE with a single
+ * timer per cell: at each expiry, all the registered UEs send their
+ * feedback, in registration order. The timer runs only while at least
+ * one UE is registered
+ */
+class SIMULTE_API LteLiteUeFeedbackDriver : public omnetpp::cSimpleModule
+{
+  private:
+    omnetpp::simtime_t fbPeriod_;    /// period for Periodic feedback in TTI
+    omnetpp::simtime_t fbDelay_;     /// time interval between sensing and transmission in TTI
+
+    FeedbackRequest feedbackReq_;    /// request sent by all the UEs
+
+    std::vector<LtePhyUe*> ues_;     /// registered UEs
+
+    omnetpp::cMessage* fbTimer_;
+
+  protected:
+
+    /**
+     * Initialization function.
+     */
+    virtual void initialize() override;
+
+    /**
+     * Triggers the feedback of all the registered UEs
+     */
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+
+  public:
+
+    LteLiteUeFeedbackDriver();
+    ~LteLiteUeFeedbackDriver();
+
+    /**
+     * Adds an UE to those sending periodic feedback.
+     * Called by PHY at initialization and after handover
+     */
+    void registerUe(LtePhyUe* phy);
+
+    /**
+     * Removes an UE from those sending periodic feedback.
+     * Called by PHY at handover and when the UE leaves the simulation
+     */
+    void unregisterUe(LtePhyUe* phy);
+};
+
+#endif
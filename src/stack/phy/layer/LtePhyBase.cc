@@ -124,6 +124,7 @@ void LtePhyBase::handleUpperMessage(cMessage* msg)
 
     if (lteInfo->getFrameType() == HARQPKT
         || lteInfo->getFrameType() == GRANTPKT
+        || lteInfo->getFrameType() == CTRLBUNDLEPKT
         || lteInfo->getFrameType() == RACPKT
         || lteInfo->getFrameType() == D2DMODESWITCHPKT)
     {
@@ -202,38 +203,62 @@ void LtePhyBase::sendMulticast(LteAirFrame *frame)
         throw cRuntimeError("LtePhyBase::sendMulticast - Error. Group ID %d is not valid.", groupId);
 
     // send the frame to nodes belonging to the multicast group only
-    std::map<int, OmnetId>::const_iterator nodeIt = binder_->getNodeIdListBegin();
-    for (; nodeIt != binder_->getNodeIdListEnd(); ++nodeIt)
+    const LteBinder::MulticastGroupMemberSet* members = binder_->getMulticastGroupMembers(groupId);
+    if (members == nullptr)
     {
-        if (nodeIt->first != nodeId_ && binder_->isInMulticastGroup(nodeIt->first, groupId))
-        {
-            EV << NOW << " LtePhyBase::sendMulticast - node " << nodeIt->first << " is in the multicast group"<< endl;
+        delete frame;
+        return;
+    }
 
-            // get a pointer to receiving module
-            cModule *receiver = getSimulation()->getModule(nodeIt->second);
-            LtePhyBase * recvPhy;
-            double dist;
+    // collect the receivers first, so that the original frame can be delivered to the last one
+    std::vector<cModule*> receivers;
+    const inet::Coord& txPos = getRadioPosition();
+    LteBinder::MulticastGroupMemberSet::const_iterator nodeIt = members->begin();
+    for (; nodeIt != members->end(); ++nodeIt)
+    {
+        if (*nodeIt == nodeId_)
+            continue;
 
-            if( enableMulticastD2DRangeCheck_ )
-            {
-                recvPhy =  check_and_cast<LtePhyBase *>(receiver->getSubmodule("lteNic")->getSubmodule("phy"));
-                dist = recvPhy->getRadioPosition().distance(getRadioPosition());
-
-                if( dist > multicastD2DRange_ )
-                {
-                    EV << NOW << " LtePhyBase::sendMulticast - node too far (" << dist << " > " << multicastD2DRange_ << ". skipping transmission" << endl;
-                    continue;
-                }
-            }
+        EV << NOW << " LtePhyBase::sendMulticast - node " << *nodeIt << " is in the multicast group"<< endl;
+
+        OmnetId omnetId = binder_->getOmnetId(*nodeIt);
+        if (omnetId == 0)
+            continue;   // the node has left the simulation
 
-            EV << NOW << " LtePhyBase::sendMulticast - sending frame to node " << nodeIt->first << endl;
+        // get a pointer to receiving module
+        cModule *receiver = getSimulation()->getModule(omnetId);
 
-            sendDirect(frame->dup(), 0, frame->getDuration(), receiver, getReceiverGateIndex(receiver));
+        if( enableMulticastD2DRangeCheck_ )
+        {
+            LtePhyBase * recvPhy =  check_and_cast<LtePhyBase *>(receiver->getSubmodule("lteNic")->getSubmodule("phy"));
+            double dist = recvPhy->getRadioPosition().distance(txPos);
+
+            if( dist > multicastD2DRange_ )
+            {
+                EV << NOW << " LtePhyBase::sendMulticast - node too far (" << dist << " > " << multicastD2DRange_ << ". skipping transmission" << endl;
+                continue;
+            }
         }
+        receivers.push_back(receiver);
     }
 
-    // delete the original frame
-    delete frame;
+    if (receivers.empty())
+    {
+        delete frame;
+        return;
+    }
+
+    // receivers do not modify the frame, hence the copies share the encapsulated packet data,
+    // and the original frame is handed over to the last receiver
+    std::vector<cModule*>::iterator rit = receivers.begin();
+    for (; rit != receivers.end(); ++rit)
+    {
+        cModule* receiver = *rit;
+        EV << NOW << " LtePhyBase::sendMulticast - sending frame to node " << receiver->getFullName() << endl;
+
+        LteAirFrame* toSend = (rit + 1 == receivers.end()) ? frame : frame->dup();
+        sendDirect(toSend, 0, toSend->getDuration(), receiver, getReceiverGateIndex(receiver));
+    }
 }
 
 void LtePhyBase::sendUnicast(LteAirFrame *frame)
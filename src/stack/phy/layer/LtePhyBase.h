@@ -277,7 +277,7 @@ class SIMULTE_API LtePhyBase : public ChannelAccess
 
     virtual void handleControlMsg(LteAirFrame *frame, UserControlInfo *userInfo);
 
-    void initializeChannelModel();
+    virtual void initializeChannelModel();
 
 
     /**
@@ -310,6 +310,10 @@ class SIMULTE_API LtePhyBase : public ChannelAccess
      * Returns the time of the last transmission performed
      */
     omnetpp::simtime_t getLastActive() { return lastActive_; }
+    /*
+     * Returns the scheduling priority of air frames
+     */
+    static short getAirFramePriority() { return airFramePriority_; }
 };
 
 #endif  /* _LTE_AIRPHYBASE_H_ */
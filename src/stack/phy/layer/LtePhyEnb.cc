@@ -84,9 +84,17 @@ void LtePhyEnb::initialize(int stage)
 
         bdcUpdateInterval_ = cellInfo_->par("broadcastMessageInterval");
         if (bdcUpdateInterval_ != 0 && par("enableHandover").boolValue()) {
-            // self message provoking the generation of a broadcast message
-            bdcStarter_ = new cMessage("bdcStarter");
-            scheduleAt(NOW, bdcStarter_);
+            if (binder_->isHandoverMeasurementCentralized())
+            {
+                // the binder measures the broadcast on behalf of the UEs in range
+                binder_->registerHandoverMeasurementSource(nodeId_, this, bdcUpdateInterval_);
+            }
+            else
+            {
+                // self message provoking the generation of a broadcast message
+                bdcStarter_ = new cMessage("bdcStarter");
+                scheduleAt(NOW, bdcStarter_);
+            }
         }
     }
     else if (stage == INITSTAGE_LINK_LAYER)
@@ -128,6 +136,7 @@ bool LtePhyEnb::handleControlPkt(UserControlInfo* lteinfo, LteAirFrame* frame)
     }
     // send H-ARQ feedback up
     if (lteinfo->getFrameType() == HARQPKT
+        || lteinfo->getFrameType() == CTRLBUNDLEPKT
         || lteinfo->getFrameType() == RACPKT)
     {
         handleControlMsg(frame, lteinfo);
@@ -208,14 +217,13 @@ void LtePhyEnb::handleAirFrame(cMessage* msg)
             EV << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
 
             /*
-             * On eNodeB set the current position
-             * to the receiving das antenna
+             * The frame is evaluated at the position of the receiving
+             * das antenna. The position registered with the channel
+             * control is not changed
              */
-            cc->setRadioPosition(myRadioRef, das_->getAntennaCoord(*it));
-
             RemoteUnitPhyData data;
             data.txPower = lteInfo->getTxPower();
-            data.m = getRadioPosition();
+            data.m = das_->getAntennaCoord(*it);
             frame->addRemoteUnitPhyDataVector(data);
         }
         result = channelModel_->isCorruptedDas(frame, lteInfo);
@@ -224,15 +224,13 @@ void LtePhyEnbD2D::handleAirFrame(cMessage* msg)
             EV << "LtePhy: Receiving Packet from antenna " << (*it) << "\n";
 
             /*
-             * On eNodeB set the current position
-             * to the receiving das antenna
+             * The frame is evaluated at the position of the receiving
+             * das antenna. The position registered with the channel
+             * control is not changed
              */
-            //move.setStart(
-            cc->setRadioPosition(myRadioRef, das_->getAntennaCoord(*it));
-
             RemoteUnitPhyData data;
             data.txPower = lteInfo->getTxPower();
-            data.m = getRadioPosition();
+            data.m = das_->getAntennaCoord(*it);
             frame->addRemoteUnitPhyDataVector(data);
         }
         result = channelModel_->isCorruptedDas(frame, lteInfo);
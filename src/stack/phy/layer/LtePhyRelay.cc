@@ -74,7 +74,7 @@ void LtePhyRelay::handleAirFrame(cMessage* msg)
     }
 
     // send H-ARQ feedback up
-    if (lteInfo->getFrameType() == HARQPKT)
+    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == CTRLBUNDLEPKT)
     {
         handleControlMsg(frame, lteInfo);
         return;
@@ -200,6 +200,17 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
     }
 
     frame->setControlInfo(lteInfo);
+    double rssi = measureBroadcast(frame, lteInfo);
+
+    EV << "UE " << nodeId_ << " broadcast frame from " << lteInfo->getSourceId() << " with RSSI: " << rssi << " at " << simTime() << endl;
+
+    evaluateHandoverCandidate(lteInfo->getSourceId(), rssi);
+
+    delete frame;
+}
+
+double LtePhyUe::measureBroadcast(LteAirFrame* frame, UserControlInfo* lteInfo)
+{
     double rssi;
 
     if (getNodeTypeById(lteInfo->getSourceId()) == ENODEB && lteInfo->getSourceId() == masterId_)
@@ -217,12 +228,14 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
             rssi += *it;
         rssi /= rssiV.size();
     }
+    return rssi;
+}
 
-    EV << "UE " << nodeId_ << " broadcast frame from " << lteInfo->getSourceId() << " with RSSI: " << rssi << " at " << simTime() << endl;
-
+void LtePhyUe::evaluateHandoverCandidate(MacNodeId sourceId, double rssi)
+{
     if (rssi > candidateMasterRssi_ + hysteresisTh_)
     {
-        if (lteInfo->getSourceId() == masterId_)
+        if (sourceId == masterId_)
         {
             // receiving even stronger broadcast from current master
             currentMasterRssi_ = rssi;
@@ -234,7 +247,7 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
         else
         {
             // broadcast from another master with higher rssi
-            candidateMasterId_ = lteInfo->getSourceId();
+            candidateMasterId_ = sourceId;
             candidateMasterRssi_ = rssi;
             hysteresisTh_ = updateHysteresisTh(rssi);
             // schedule self message to evaluate handover parameters after
@@ -249,13 +262,56 @@ void LtePhyUe::handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo)
     }
     else
     {
-        if (lteInfo->getSourceId() == masterId_)
+        if (sourceId == masterId_)
         {
             currentMasterRssi_ = rssi;
             candidateMasterRssi_ = rssi;
             hysteresisTh_ = updateHysteresisTh(rssi);
         }
     }
+}
+
+void LtePhyUe::handleHandoverCandidates(const std::vector<HandoverCandidate>& candidates)
+{
+    Enter_Method_Silent("handleHandoverCandidates");
+
+    // same check as for received broadcast frames
+    if (handoverTrigger_ != nullptr && handoverTrigger_->isScheduled())
+        return;
+
+    // fictitious broadcast frame, reused for all the candidates
+    LteAirFrame* frame = new LteAirFrame("handoverFrame");
+    UserControlInfo* cInfo = new UserControlInfo();
+    cInfo->setIsBroadcast(true);
+    cInfo->setIsCorruptible(false);
+    cInfo->setFrameType(HANDOVERPKT);
+    cInfo->setDestId(nodeId_);
+    frame->setControlInfo(cInfo);
+
+    std::vector<HandoverCandidate>::const_iterator it = candidates.begin();
+    for (; it != candidates.end(); ++it)
+    {
+        if (binder_->getOmnetId(it->id) == 0)
+            continue;   // source has left the simulation
+
+        cInfo->setSourceId(it->id);
+        cInfo->setTxPower(it->txPower);
+        cInfo->setCoord(it->coord);
+
+        if (!enableHandover_)
+        {
+            // the reporting set must be computed anyway
+            if (getNodeTypeById(it->id) == ENODEB && it->id == masterId_)
+                das_->receiveBroadcast(frame, cInfo);
+            continue;
+        }
+
+        double rssi = measureBroadcast(frame, cInfo);
+
+        EV << "UE " << nodeId_ << " measured broadcast from " << it->id << " with RSSI: " << rssi << " at " << simTime() << endl;
+
+        evaluateHandoverCandidate(it->id, rssi);
+    }
 
     delete frame;
 }
@@ -324,9 +380,10 @@ void LtePhyUe::doHandover()
     newCellInfo->attachUser(nodeId_);
     cellInfo_ = newCellInfo;
 
-    // update DL feedback generator
-    LteDlFeedbackGenerator* fbGen = check_and_cast<LteDlFeedbackGenerator*>(getParentModule()->getSubmodule("dlFbGen"));
-    fbGen->handleHandover(masterId_);
+    // update DL feedback generator (lite UEs have none)
+    cModule* fbGenModule = getParentModule()->getSubmodule("dlFbGen");
+    if (fbGenModule != nullptr)
+        check_and_cast<LteDlFeedbackGenerator*>(fbGenModule)->handleHandover(masterId_);
 
     // collect stat
     emit(servingCell_, (long)masterId_);
@@ -409,7 +466,7 @@ void LtePhyUe::handleAirFrame(cMessage* msg)
     }
 
         // send H-ARQ feedback up
-    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == RACPKT)
+    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == CTRLBUNDLEPKT || lteInfo->getFrameType() == RACPKT)
     {
         handleControlMsg(frame, lteInfo);
         return;
@@ -17,6 +17,17 @@
 
 class DasFilter;
 
+/**
+ * Serving cell candidate measured by the binder, carrying the
+ * parameters of the handover broadcast it replaces
+ */
+struct HandoverCandidate
+{
+    MacNodeId id;
+    double txPower;
+    inet::Coord coord;
+};
+
 class SIMULTE_API LtePhyUe : public LtePhyBase
 {
   protected:
@@ -109,6 +120,18 @@ class SIMULTE_API LtePhyUe : public LtePhyBase
 
     void handoverHandler(LteAirFrame* frame, UserControlInfo* lteInfo);
 
+    /**
+     * Compute the RSSI of a handover broadcast, updating the DAS reporting set
+     * if it comes from the master
+     */
+    double measureBroadcast(LteAirFrame* frame, UserControlInfo* lteInfo);
+
+    /**
+     * Update the handover candidate with the RSSI measured from the given node,
+     * scheduling the handover evaluation if needed
+     */
+    void evaluateHandoverCandidate(MacNodeId sourceId, double rssi);
+
     void deleteOldBuffers(MacNodeId masterId);
 
     virtual void triggerHandover();
@@ -118,6 +141,11 @@ class SIMULTE_API LtePhyUe : public LtePhyBase
     LtePhyUe();
     virtual ~LtePhyUe();
     DasFilter *getDasFilter();
+    /**
+     * Called by the binder when handover broadcasts are measured centrally:
+     * each candidate is handled as a broadcast received from it, in order
+     */
+    virtual void handleHandoverCandidates(const std::vector<HandoverCandidate>& candidates);
     /**
      * Send Feedback, called by feedback generator in DL
      */
@@ -33,6 +33,16 @@ void LtePhyUeD2D::initialize(int stage)
         averageCqiD2D_ = registerSignal("averageCqiD2D");
         d2dTxPower_ = par("d2dTxPower");
         d2dMulticastEnableCaptureEffect_ = par("d2dMulticastCaptureEffect");
+        const char* captureFactor = par("d2dMulticastCaptureEffectFactor").stringValue();
+        if (strcmp(captureFactor, "RSRP") == 0)
+            d2dMulticastCaptureByRsrp_ = true;
+        else if (strcmp(captureFactor, "distance") == 0)
+            d2dMulticastCaptureByRsrp_ = false;
+        else
+            throw cRuntimeError("LtePhyUeD2D::initialize - unknown capture effect factor %s", captureFactor);
+        d2dMulticastCaptureFilterMargin_ = par("d2dMulticastCaptureFilterMargin");
+        d2dCaptureFilteredFrames_ = registerSignal("d2dCaptureFilteredFrames");
+        d2dCaptureLostFrames_ = registerSignal("d2dCaptureLostFrames");
         d2dDecodingTimer_ = nullptr;
     }
 }
@@ -127,7 +137,7 @@ void LtePhyUeD2D::handleAirFrame(cMessage* msg)
     }
 
     // send H-ARQ feedback up
-    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == RACPKT || lteInfo->getFrameType() == D2DMODESWITCHPKT)
+    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == CTRLBUNDLEPKT || lteInfo->getFrameType() == RACPKT || lteInfo->getFrameType() == D2DMODESWITCHPKT)
     {
         handleControlMsg(frame, lteInfo);
         return;
@@ -281,7 +291,7 @@ void LtePhyUeD2D::handleUpperMessage(cMessage* msg)
     EV << NOW << " LtePhyUeD2D::handleUpperMessage - message from stack" << endl;
     LteAirFrame* frame = nullptr;
 
-    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == RACPKT)
+    if (lteInfo->getFrameType() == HARQPKT || lteInfo->getFrameType() == GRANTPKT || lteInfo->getFrameType() == CTRLBUNDLEPKT || lteInfo->getFrameType() == RACPKT)
     {
         frame = new LteAirFrame("harqFeedback-grant");
     }
@@ -320,94 +330,107 @@ void LtePhyUeD2D::storeAirFrame(LteAirFrame* newFrame)
     // implements the capture effect
     // store the frame received from the nearest transmitter
     UserControlInfo* newInfo = check_and_cast<UserControlInfo*>(newFrame->getControlInfo());
-    Coord myCoord = getCoord();
-    double distance = 0.0;
-    double rsrpMean = 0.0;
-    std::vector<double> rsrpVector;
-    bool useRsrp = false;
+    const Coord& myCoord = getCoord();
 
-    if (strcmp(par("d2dMulticastCaptureEffectFactor"),"RSRP") == 0)
-    {
-        useRsrp = true;
-
-        double sum = 0.0;
-        unsigned int allocatedRbs = 0;
-        rsrpVector = channelModel_->getRSRP_D2D(newFrame, newInfo, nodeId_, myCoord);
-
-        // get the average RSRP on the RBs allocated for the transmission
-        RbMap rbmap = newInfo->getGrantedBlocks();
-        RbMap::iterator it;
-        std::map<Band, unsigned int>::iterator jt;
-        //for each Remote unit used to transmit the packet
-        for (it = rbmap.begin(); it != rbmap.end(); ++it)
-        {
-            //for each logical band used to transmit the packet
-            for (jt = it->second.begin(); jt != it->second.end(); ++jt)
-            {
-                Band band = jt->first;
-                if (jt->second == 0) // this Rb is not allocated
-                    continue;
-
-                sum += rsrpVector.at(band);
-                allocatedRbs++;
-            }
-        }
-        rsrpMean = sum / allocatedRbs;
-        EV << "LtePhyUeD2D::storeAirFrame - Average RSRP from node " << newInfo->getSourceId() << ": " << rsrpMean << endl;
-    }
-    else  // distance
+    if (!d2dMulticastCaptureByRsrp_)
     {
-        Coord newSenderCoord = newInfo->getCoord();
-        distance = myCoord.distance(newSenderCoord);
-        EV << NOW << " LtePhyUeD2D::storeAirFrame - Distance from node " << newInfo->getSourceId() << ": " << distance << endl;
-    }
+        // squared distances are enough for comparing them
+        double distance = myCoord.sqrdist(newInfo->getCoord());
+        EV << NOW << " LtePhyUeD2D::storeAirFrame - Distance from node " << newInfo->getSourceId() << ": " << sqrt(distance) << endl;
 
-    if (!d2dReceivedFrames_.empty())
-    {
-        LteAirFrame* prevFrame = d2dReceivedFrames_.front();
-        if (!useRsrp && distance < nearestDistance_)
+        if (d2dReceivedFrames_.empty())
         {
-            EV << "[ < nearestDistance: " << nearestDistance_ << "]" << endl;
-
-            // remove the previous frame
-            d2dReceivedFrames_.pop_back();
-            delete prevFrame;
-
             nearestDistance_ = distance;
             d2dReceivedFrames_.push_back(newFrame);
         }
-        else if (rsrpMean > bestRsrpMean_)
+        else if (distance < nearestDistance_)
         {
-            EV << "[ > bestRsrp: " << bestRsrpMean_ << "]" << endl;
+            EV << "[ < nearestDistance: " << sqrt(nearestDistance_) << "]" << endl;
 
             // remove the previous frame
+            LteAirFrame* prevFrame = d2dReceivedFrames_.front();
             d2dReceivedFrames_.pop_back();
             delete prevFrame;
+            emit(d2dCaptureFilteredFrames_, (long)1);
 
-            bestRsrpMean_ = rsrpMean;
-            bestRsrpVector_ = rsrpVector;
+            nearestDistance_ = distance;
             d2dReceivedFrames_.push_back(newFrame);
         }
         else
         {
             // this frame will not be decoded
             delete newFrame;
+            emit(d2dCaptureFilteredFrames_, (long)1);
         }
+        return;
     }
-    else
+
+    // pre-filter: skip the computation of the RSRP if the frame cannot beat the stored one
+    if (!d2dReceivedFrames_.empty() && d2dMulticastCaptureFilterMargin_ >= 0)
     {
-        if (!useRsrp)
+        double meanRsrp = channelModel_->getMeanRSRP_D2D(newInfo, nodeId_, myCoord);
+        if (meanRsrp + d2dMulticastCaptureFilterMargin_ <= bestRsrpMean_)
         {
-            nearestDistance_ = distance;
-            d2dReceivedFrames_.push_back(newFrame);
+            EV << NOW << " LtePhyUeD2D::storeAirFrame - Mean RSRP from node " << newInfo->getSourceId() << ": " << meanRsrp << " [ <= bestRsrp: " << bestRsrpMean_ << "], discarded" << endl;
+
+            // this frame will not be decoded
+            delete newFrame;
+            emit(d2dCaptureFilteredFrames_, (long)1);
+            return;
         }
-        else
+    }
+
+    double sum = 0.0;
+    unsigned int allocatedRbs = 0;
+    std::vector<double> rsrpVector = channelModel_->getRSRP_D2D(newFrame, newInfo, nodeId_, myCoord);
+
+    // get the average RSRP on the RBs allocated for the transmission
+    const RbMap& rbmap = newInfo->getGrantedBlocks();
+    RbMap::const_iterator it;
+    std::map<Band, unsigned int>::const_iterator jt;
+    //for each Remote unit used to transmit the packet
+    for (it = rbmap.begin(); it != rbmap.end(); ++it)
+    {
+        //for each logical band used to transmit the packet
+        for (jt = it->second.begin(); jt != it->second.end(); ++jt)
         {
-            bestRsrpMean_ = rsrpMean;
-            bestRsrpVector_ = rsrpVector;
-            d2dReceivedFrames_.push_back(newFrame);
+            Band band = jt->first;
+            if (jt->second == 0) // this Rb is not allocated
+                continue;
+
+            sum += rsrpVector.at(band);
+            allocatedRbs++;
         }
     }
+    double rsrpMean = sum / allocatedRbs;
+    EV << "LtePhyUeD2D::storeAirFrame - Average RSRP from node " << newInfo->getSourceId() << ": " << rsrpMean << endl;
+
+    if (d2dReceivedFrames_.empty())
+    {
+        bestRsrpMean_ = rsrpMean;
+        bestRsrpVector_.swap(rsrpVector);
+        d2dReceivedFrames_.push_back(newFrame);
+    }
+    else if (rsrpMean > bestRsrpMean_)
+    {
+        EV << "[ > bestRsrp: " << bestRsrpMean_ << "]" << endl;
+
+        // remove the previous frame
+        LteAirFrame* prevFrame = d2dReceivedFrames_.front();
+        d2dReceivedFrames_.pop_back();
+        delete prevFrame;
+        emit(d2dCaptureLostFrames_, (long)1);
+
+        bestRsrpMean_ = rsrpMean;
+        bestRsrpVector_.swap(rsrpVector);
+        d2dReceivedFrames_.push_back(newFrame);
+    }
+    else
+    {
+        // this frame will not be decoded
+        delete newFrame;
+        emit(d2dCaptureLostFrames_, (long)1);
+    }
 }
 
 LteAirFrame* LtePhyUeD2D::extractAirFrame()
@@ -23,12 +23,18 @@ class SIMULTE_API LtePhyUeD2D : public LtePhyUe
      * Capture Effect for D2D Multicast communications
      */
     bool d2dMulticastEnableCaptureEffect_;
-    double nearestDistance_;
+    bool d2dMulticastCaptureByRsrp_;              // if false, capture the frame from the nearest transmitter
+    double d2dMulticastCaptureFilterMargin_;      // if >= 0, discard frames whose mean RSRP (plus this margin) is not
+                                                  // greater than the best RSRP, without computing their actual RSRP
+    double nearestDistance_;                      // squared distance from the nearest transmitter
     std::vector<double> bestRsrpVector_;
     double bestRsrpMean_;
     std::vector<LteAirFrame*> d2dReceivedFrames_; // airframes received in the current TTI. Only one will be decoded
     omnetpp::cMessage* d2dDecodingTimer_;                  // timer for triggering decoding at the end of the TTI. Started
                                                   // when the first airframe is received
+    omnetpp::simsignal_t d2dCaptureFilteredFrames_;   // frames discarded before computing their RSRP (or by distance)
+    omnetpp::simsignal_t d2dCaptureLostFrames_;       // frames whose RSRP has been computed, but have not been captured
+
     void storeAirFrame(LteAirFrame* newFrame);
     LteAirFrame* extractAirFrame();
     void decodeAirFrame(LteAirFrame* frame, UserControlInfo* lteInfo);
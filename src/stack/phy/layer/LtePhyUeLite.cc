@@ -0,0 +1,96 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#include "stack/phy/layer/LtePhyUeLite.h"
+
+Define_Module(LtePhyUeLite);
+
+using namespace omnetpp;
+
+LtePhyUeLite::LtePhyUeLite()
+{
+    fbDriver_ = nullptr;
+}
+
+void LtePhyUeLite::initialize(int stage)
+{
+    // the shared channel model may have been used by other UEs since it was bound
+    if (stage == inet::INITSTAGE_PHYSICAL_LAYER)
+        channelModel_->setPhy(this);
+
+    LtePhyUe::initialize(stage);
+
+    if (stage == inet::INITSTAGE_PHYSICAL_LAYER)
+    {
+        // the serving cell is known only now, if dynamic cell association is enabled
+        if (dynamicCellAssociation_)
+            bindChannelModel(masterId_);
+        bindFeedbackDriver(masterId_);
+    }
+}
+
+void LtePhyUeLite::initializeChannelModel()
+{
+    // cell selection is performed with the model of the configured cell
+    bindChannelModel(getAncestorPar("masterId"));
+}
+
+cModule* LtePhyUeLite::getLiteUeSupport(MacNodeId cellId)
+{
+    cModule* enb = getSimulation()->getModule(binder_->getOmnetId(cellId));
+    cModule* liteUe = (enb != nullptr) ? enb->getSubmodule("lteNic")->getSubmodule("liteUe") : nullptr;
+    if (liteUe == nullptr)
+        throw cRuntimeError("LtePhyUeLite::getLiteUeSupport - eNB %d does not serve lite UEs (set liteUeSupport = true)", cellId);
+    return liteUe;
+}
+
+void LtePhyUeLite::bindChannelModel(MacNodeId cellId)
+{
+    channelModel_ = check_and_cast<LteChannelModel*>(getLiteUeSupport(cellId)->getSubmodule("channelModel"));
+    channelModel_->setBand(binder_->getNumBands());
+    channelModel_->setPhy(this);
+}
+
+void LtePhyUeLite::bindFeedbackDriver(MacNodeId cellId)
+{
+    fbDriver_ = check_and_cast<LteLiteUeFeedbackDriver*>(getLiteUeSupport(cellId)->getSubmodule("feedbackDriver"));
+    fbDriver_->registerUe(this);
+}
+
+void LtePhyUeLite::handleAirFrame(cMessage* msg)
+{
+    channelModel_->setPhy(this);
+    LtePhyUe::handleAirFrame(msg);
+}
+
+void LtePhyUeLite::handleHandoverCandidates(const std::vector<HandoverCandidate>& candidates)
+{
+    channelModel_->setPhy(this);
+    LtePhyUe::handleHandoverCandidates(candidates);
+}
+
+void LtePhyUeLite::doHandover()
+{
+    fbDriver_->unregisterUe(this);
+
+    LtePhyUe::doHandover();
+
+    EV << NOW << " LtePhyUeLite::doHandover - UE " << nodeId_ << " uses the channel model of eNB " << masterId_ << endl;
+    bindChannelModel(masterId_);
+    bindFeedbackDriver(masterId_);
+}
+
+void LtePhyUeLite::finish()
+{
+    // do this only at deletion of the module during the simulation
+    if (getSimulation()->getSimulationStage() != CTX_FINISH && fbDriver_ != nullptr)
+        fbDriver_->unregisterUe(this);
+
+    LtePhyUe::finish();
+}
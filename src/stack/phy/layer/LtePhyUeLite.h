@@ -0,0 +1,54 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_AIRPHYUELITE_H_
+#define _LTE_AIRPHYUELITE_H_
+
+#include "stack/phy/layer/LtePhyUe.h"
+#include "stack/phy/feedback/LteLiteUeFeedbackDriver.h"
+
+/**
+ * PHY layer of a lite UE.
+ *
+ * The channel model is the one shared by the lite UEs of the serving
+ * cell: since it refers to the PHY of the receiver, it is bound to this
+ * module before each use. The periodic feedback is triggered by the
+ * feedback driver of the serving cell
+ */
+class SIMULTE_API LtePhyUeLite : public LtePhyUe
+{
+  protected:
+    /** Feedback driver of the serving cell */
+    LteLiteUeFeedbackDriver* fbDriver_;
+
+    virtual void initialize(int stage) override;
+    virtual void initializeChannelModel() override;
+    virtual void handleAirFrame(omnetpp::cMessage* msg) override;
+    virtual void finish() override;
+    virtual void finish(cComponent *component, omnetpp::simsignal_t signalID) override {cIListener::finish(component, signalID);}
+
+    virtual void doHandover() override;
+
+    /**
+     * Return the module holding the state shared by the lite UEs of the given cell
+     */
+    omnetpp::cModule* getLiteUeSupport(MacNodeId cellId);
+
+    /**
+     * Use the channel model and the feedback driver of the given cell
+     */
+    void bindChannelModel(MacNodeId cellId);
+    void bindFeedbackDriver(MacNodeId cellId);
+
+  public:
+    LtePhyUeLite();
+    virtual void handleHandoverCandidates(const std::vector<HandoverCandidate>& candidates) override;
+};
+
+#endif  /* _LTE_AIRPHYUELITE_H_ */
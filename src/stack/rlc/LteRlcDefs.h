@@ -14,6 +14,12 @@
 #include "stack/rlc/packet/LteRlcPdu_m.h"
 #include "stack/rlc/packet/LteRlcSdu_m.h"
 
+/*!
+ * Maximum size of RLC transmission/reception windows: half of the
+ * sequence number space, with the longest (18 bits) sequence numbers
+ */
+const unsigned int RLC_MAX_WINDOW_SIZE = 131072;
+
 /*!
  * LTE RLC AM Types
  */
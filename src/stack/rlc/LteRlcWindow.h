@@ -0,0 +1,188 @@
+//
+//                           SimuLTE
+//
+// This file is part of a software released under the license included in file
+// "license.pdf". This license can be also found at http://www.ltesimulator.com/
+// The above file and the present reference are part of the software itself,
+// and cannot be removed from it.
+//
+
+#ifndef _LTE_LTERLCWINDOW_H_
+#define _LTE_LTERLCWINDOW_H_
+
+#include <vector>
+#include <omnetpp.h>
+
+/*!
+ * Per-position state of a RLC transmission/reception window.
+ *
+ * Positions are relative to the beginning of the window, and are mapped onto
+ * a circular array: moving the window forth by n positions only resets the n
+ * positions leaving the window, whatever the window size.
+ */
+template<typename T>
+class RlcRingWindow
+{
+  public:
+    typedef typename std::vector<T>::reference reference;
+    typedef typename std::vector<T>::const_reference const_reference;
+
+    RlcRingWindow()
+    {
+        base_ = 0;
+    }
+
+    //! Set the window size, resetting all positions to the given value
+    void resize(unsigned int size, const T& value = T())
+    {
+        slots_.assign(size, value);
+        base_ = 0;
+    }
+
+    unsigned int size() const
+    {
+        return slots_.size();
+    }
+
+    //! Access the state of the i-th position of the window
+    reference at(unsigned int i)
+    {
+        return slots_.at(physical(i));
+    }
+
+    const_reference at(unsigned int i) const
+    {
+        return slots_.at(physical(i));
+    }
+
+    reference operator[](unsigned int i)
+    {
+        return slots_[physical(i)];
+    }
+
+    const_reference operator[](unsigned int i) const
+    {
+        return slots_[physical(i)];
+    }
+
+    /*!
+     * Move the window forth by n positions. The positions entering the
+     * window (at its end) are set to the given value
+     */
+    void shift(unsigned int n, const T& value = T())
+    {
+        if (n > slots_.size())
+            throw omnetpp::cRuntimeError("RlcRingWindow::shift(): shifting by %d positions a window of size %d", n, (int)slots_.size());
+        for (unsigned int i = 0; i < n; ++i)
+            slots_[physical(i)] = value;
+        base_ = physical(n);
+    }
+
+  protected:
+    unsigned int physical(unsigned int i) const
+    {
+        unsigned int p = base_ + i;
+        return (p >= slots_.size()) ? p - slots_.size() : p;
+    }
+
+    std::vector<T> slots_;
+
+    //! Position of the beginning of the window in the circular array
+    unsigned int base_;
+};
+
+/*!
+ * Buffer of the PDUs within a RLC transmission/reception window.
+ *
+ * It has the same interface as the cArray previously used for this purpose
+ * (PDUs are owned by the buffer), but positions are relative to the beginning
+ * of the window, which is moved forth by shift() in a time proportional to
+ * the number of positions leaving the window.
+ */
+class RlcPduWindow
+{
+  public:
+    RlcPduWindow(const char *name = nullptr) : pdus_(name)
+    {
+        base_ = 0;
+        size_ = 0;
+    }
+
+    //! Set the window size. The buffer must be empty
+    void resize(unsigned int size)
+    {
+        pdus_.clear();
+        pdus_.setCapacity(size);
+        size_ = size;
+        base_ = 0;
+    }
+
+    unsigned int size() const
+    {
+        return size_;
+    }
+
+    omnetpp::cObject *get(unsigned int i)
+    {
+        return (i < size_) ? pdus_.get(physical(i)) : nullptr;
+    }
+
+    const omnetpp::cObject *get(unsigned int i) const
+    {
+        return (i < size_) ? pdus_.get(physical(i)) : nullptr;
+    }
+
+    //! Store a PDU at the i-th position, which must be free
+    void addAt(unsigned int i, omnetpp::cObject *obj)
+    {
+        if (i >= size_)
+            throw omnetpp::cRuntimeError("RlcPduWindow::addAt(): position %d out of a window of size %d", i, size_);
+        pdus_.addAt(physical(i), obj);
+    }
+
+    //! Detach the PDU at the i-th position, if any
+    omnetpp::cObject *remove(unsigned int i)
+    {
+        return (i < size_) ? pdus_.remove(physical(i)) : nullptr;
+    }
+
+    //! Delete all the buffered PDUs
+    void clear()
+    {
+        pdus_.clear();
+    }
+
+    /*!
+     * Move the window forth by n positions. PDUs still buffered in the
+     * positions leaving the window are deleted
+     */
+    void shift(unsigned int n)
+    {
+        if (n > size_)
+            throw omnetpp::cRuntimeError("RlcPduWindow::shift(): shifting by %d positions a window of size %d", n, size_);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            omnetpp::cObject *obj = pdus_.remove(physical(i));
+            if (obj != nullptr)
+                delete obj;
+        }
+        base_ = physical(n);
+    }
+
+  protected:
+    unsigned int physical(unsigned int i) const
+    {
+        unsigned int p = base_ + i;
+        return (p >= size_) ? p - size_ : p;
+    }
+
+    omnetpp::cArray pdus_;
+
+    //! Position of the beginning of the window in the circular array
+    unsigned int base_;
+
+    //! Window size
+    unsigned int size_;
+};
+
+#endif
@@ -22,7 +22,7 @@ using namespace omnetpp;
 unsigned int AmRxQueue::totalCellRcvdBytes_ = 0;
 
 AmRxQueue::AmRxQueue() :
-    timer_(this)
+    timerWheel_(this), timer_(&timerWheel_)
 {
     rxWindowDesc_.firstSeqNum_ = 0;
     rxWindowDesc_.seqNum_ = 0;
@@ -44,6 +44,9 @@ void AmRxQueue::initialize()
     ackReportInterval_ = par("ackReportInterval");
     statusReportInterval_ = par("statusReportInterval");
 
+    if (rxWindowDesc_.windowSize_ == 0 || rxWindowDesc_.windowSize_ > RLC_MAX_WINDOW_SIZE)
+        throw cRuntimeError("AmRxQueue::initialize(): invalid rxWindowSize %d", rxWindowDesc_.windowSize_);
+    pduBuffer_.resize(rxWindowDesc_.windowSize_);
     discarded_.resize(rxWindowDesc_.windowSize_);
     received_.resize(rxWindowDesc_.windowSize_);
     totalRcvdBytes_ = 0;
@@ -81,32 +84,32 @@ void AmRxQueue::initialize()
 
 void AmRxQueue::handleMessage(cMessage* msg)
 {
-    if (!(msg->isSelfMessage()))
+    if (!timerWheel_.isTimerMessage(msg))
         throw cRuntimeError("Unexpected message received from AmRxQueue");
 
-    EV << NOW << "AmRxQueue::handleMessage timer event received, sending status report " << endl;
-
-    // signal timer event handled
-    timer_.handle();
+    // the timer message is owned by the wheel
+    unsigned int timerId, event;
+    while (timerWheel_.popExpired(timerId, event))
+    {
+        EV << NOW << "AmRxQueue::handleMessage timer event received, sending status report " << endl;
 
-    // Send status report to the AM Tx entity
-    sendStatusReport();
+        // Send status report to the AM Tx entity
+        sendStatusReport();
 
-    // Reschedule the timer if there are PDUs in the buffer
+        // Reschedule the timer if there are PDUs in the buffer
 
-    for (unsigned int i = 0; i < rxWindowDesc_.windowSize_; i++)
-    {
-        if (pduBuffer_.get(i) != nullptr)
+        for (unsigned int i = 0; i < rxWindowDesc_.windowSize_; i++)
         {
-            timer_.start(statusReportInterval_);
-            break;
+            if (pduBuffer_.get(i) != nullptr)
+            {
+                timer_.start(statusReportInterval_);
+                break;
+            }
         }
     }
-
-    delete msg;
 }
 
-Packet *AmRxQueue::defragmentFrames(std::deque<Packet *> &fragmentFrames)
+Packet *AmRxQueue::defragmentFrames(const std::deque<Packet *> &fragmentFrames)
 {
     EV_DEBUG << "Defragmenting " << fragmentFrames.size() << " fragments.\n";
     auto defragmentedFrame = new Packet();
@@ -117,14 +120,13 @@ Packet *AmRxQueue::defragmentFrames(std::deque<Packet *> &fragmentFrames)
     if (index != std::string::npos)
         defragmentedFrame->setName(defragmentedName.substr(0, index).c_str());
 
+    // fragments are left untouched: the SDU is stitched from references to their data (which
+    // are slices of the original SDU content), and contiguous slices are merged back by INET
     for (auto fragmentFrame : fragmentFrames) {
-        fragmentFrame->popAtFront<LteRlcAmPdu>();
-        defragmentedFrame->insertAtBack(fragmentFrame->peekData());
-        delete fragmentFrame;
+        b headerLength = fragmentFrame->peekAtFront<LteRlcAmPdu>()->getChunkLength();
+        defragmentedFrame->insertAtBack(fragmentFrame->peekDataAt(headerLength, fragmentFrame->getDataLength() - headerLength));
     }
 
-    fragmentFrames.clear();
-
     EV_TRACE << "Created " << *defragmentedFrame << ".\n";
 
     return defragmentedFrame;
@@ -349,6 +351,7 @@ void AmRxQueue::passUp(const int index)
     if (!header->isWhole()) {
         // assemble frame
         std::deque<Packet *>frameBuff;
+        std::deque<Packet *>pendingFrames;
         const auto pkId = header->getSnoMainPacket();
 
         // handle special case: some fragments have already been moved out of the receive window and
@@ -361,16 +364,16 @@ void AmRxQueue::passUp(const int index)
                 }
                 frameBuff.push_back(p);
             }
-            pendingPduBuffer_.clear();
+            pendingFrames.swap(pendingPduBuffer_);
         }
 
         int auxIndex = index;
 
         for (int i = 0; i < pduBuffer_.size() && frameBuff.size() < header->getTotalFragments(); i++) {
             auto headerAux = check_and_cast<Packet*>(pduBuffer_.get(auxIndex))->peekAtFront<LteRlcAmPdu>();
-            // duplicate buffered PDU. We cannot detach it from receiver window until a move Rx command is executed.
+            // buffered PDUs are only referenced. We cannot detach them from receiver window until a move Rx command is executed.
             if (pkId == headerAux->getSnoMainPacket())
-                frameBuff.push_back(check_and_cast<Packet*>(pduBuffer_.get(auxIndex))->dup());
+                frameBuff.push_back(check_and_cast<Packet*>(pduBuffer_.get(auxIndex)));
             auxIndex++;
             if (auxIndex >= pduBuffer_.size())
                 auxIndex = 0;
@@ -378,6 +381,10 @@ void AmRxQueue::passUp(const int index)
 
         // now all fragments (PDUs) are available and the SDU can be defragmented
         pkt = defragmentFrames(frameBuff);
+
+        // fragments moved out of the receive window are not needed anymore
+        for (auto p : pendingFrames)
+            delete p;
     }
     else
     {
@@ -745,21 +752,10 @@ void AmRxQueue::moveRxWindow(const int seqNum)
         }
     }
 
-    for ( int i = pos; i < rxWindowDesc_.windowSize_; ++i)
-    {
-        if (pduBuffer_.get(i) != nullptr)
-        {
-            pduBuffer_.addAt(i-pos, pduBuffer_.remove(i));
-        }
-        else
-        {
-            pduBuffer_.remove(i);
-        }
-        received_.at(i-pos) = received_.at(i);
-        discarded_.at(i-pos) = discarded_.at(i);
-        received_.at(i) = false;
-        discarded_.at(i) = false;
-    }
+    // only the positions leaving the window are touched
+    pduBuffer_.shift(pos);
+    received_.shift(pos, false);
+    discarded_.shift(pos, false);
 
     rxWindowDesc_.firstSeqNum_ += pos;
 
@@ -11,7 +11,8 @@
 #define _LTE_AMRXBUFFER_H_
 
 #include "stack/rlc/LteRlcDefs.h"
-#include "common/timer/TTimer.h"
+#include "stack/rlc/LteRlcWindow.h"
+#include "common/timer/TTimerWheel.h"
 #include "stack/rlc/am/LteRlcAm.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu.h"
 #include "stack/rlc/am/packet/LteRlcAmSdu_m.h"
@@ -40,11 +41,14 @@ class SIMULTE_API AmRxQueue : public omnetpp::cSimpleModule
     //! SDU reconstructed at the beginning of the Receiver buffer
     int firstSdu_;
 
+    //! Timing wheel serving the timer below
+    TTimerWheel timerWheel_;
+
     //! Timer to manage the buffer status report
-    TTimer timer_;
+    TWheelTimer timer_;
 
     //! AM PDU buffer
-    omnetpp::cArray pduBuffer_;
+    RlcPduWindow pduBuffer_;
 
     //! AM PDU fragment buffer
     //  (stores PDUs of the next SDU if they are shifted out of the PDU buffer before the SDU is completely
@@ -54,12 +58,12 @@ class SIMULTE_API AmRxQueue : public omnetpp::cSimpleModule
     //! AM PDU Received vector
     /** For each AM PDU a received status variable is kept.
      */
-    std::vector<bool> received_;
+    RlcRingWindow<bool> received_;
 
     //! AM PDU Discarded Vector
     /** For each AM PDU a discarded status variable is kept.
      */
-    std::vector<bool> discarded_;
+    RlcRingWindow<bool> discarded_;
 
     /*
      * FlowControlInfo matrix : used for CTRL messages generation
@@ -127,7 +131,10 @@ class SIMULTE_API AmRxQueue : public omnetpp::cSimpleModule
     void discard(const int sn);
 
     //! Defragment received frame
-    inet::Packet *defragmentFrames(std::deque<inet::Packet *> &fragmentFrames);
+    /** The fragments are not modified nor deleted: the returned SDU
+     *  references their data instead of copying it
+     */
+    inet::Packet *defragmentFrames(const std::deque<inet::Packet *> &fragmentFrames);
 };
 
 #endif
@@ -14,7 +14,7 @@
 Define_Module(AmTxQueue);
 
 AmTxQueue::AmTxQueue() :
-    pduTimer_(this), mrwTimer_(this), bufferStatusTimer_(this)
+    timerWheel_(this), pduTimer_(&timerWheel_), mrwTimer_(&timerWheel_), bufferStatusTimer_(&timerWheel_)
 {
     currentSdu_ = nullptr;
     lteInfo_ = nullptr;
@@ -34,7 +34,10 @@ void AmTxQueue::initialize()
     ctrlPduRtxTimeout_ = par("ctrlPduRtxTimeout");
     bufferStatusTimeout_ = par("bufferStatusTimeout");
     txWindowDesc_.windowSize_ = par("txWindowSize");
+    if (txWindowDesc_.windowSize_ == 0 || txWindowDesc_.windowSize_ > RLC_MAX_WINDOW_SIZE)
+        throw cRuntimeError("AmTxQueue::initialize(): invalid txWindowSize %d", txWindowDesc_.windowSize_);
     // resize status vectors
+    pduRtxQueue_.resize(txWindowDesc_.windowSize_);
     received_.resize(txWindowDesc_.windowSize_, false);
     discarded_.resize(txWindowDesc_.windowSize_+1, false);
 
@@ -94,53 +97,35 @@ void AmTxQueue::enque(Packet *pkt)
     }
 }
 
-std::deque<Packet *> *AmTxQueue::fragmentFrame(Packet *frame, std::deque<int>& windowsIndex, RlcFragDesc rlcFragDesc)
+Packet *AmTxQueue::makeFragment(const RlcFragDesc& rlcFragDesc)
 {
-
-    EV_DEBUG << "Fragmenting " << *frame << " into " << rlcFragDesc.totalFragments_ << " fragments.\n";
-    B offset = B(0);
-    std::deque<Packet *> *fragments = new std::deque<Packet *>();
-    const auto& frameHeader = frame->peekAtFront<LteRlcAmSdu>();
-    windowsIndex.clear();
-    RlcWindowDesc tmp = txWindowDesc_;
+    // the fragment is a view of the current SDU: its data is a slice of the
+    // (immutable) SDU content, hence no SDU data is copied
+    int index = rlcFragDesc.fragCounter_;
     B fragUnit = B(rlcFragDesc.fragUnit_);
+    B offset = fragUnit * index;
+    // length is equal to fragmentation unit except for last fragment
+    B length = (index == rlcFragDesc.totalFragments_ - 1) ? B(currentSdu_->getTotalLength()) - offset : fragUnit;
 
-    for (size_t i = 0; i < rlcFragDesc.totalFragments_; i++) {
-        std::string name = std::string(frame->getName()) + "-frag" + std::to_string(i);
-        auto fragment = new Packet(name.c_str());
-        // length is equal to fragmentation unit except for last fragment
-        B length = (i == rlcFragDesc.totalFragments_-1) ? B(frame->getTotalLength()) - offset : fragUnit;
-        fragment->insertAtBack(frame->peekDataAt(offset, length));
-        offset += length;
-        // fragment->insertAtFront(frameHeader);
-        auto pdu = makeShared<LteRlcAmPdu>();
-        // set RLC type descriptor
-        pdu->setAmType(DATA);
-        // set fragmentation info
-        pdu->setTotalFragments(rlcFragDesc.totalFragments_);
-        pdu->setSnoFragment(tmp.seqNum_);
-        pdu->setFirstSn(rlcFragDesc.firstSn_);
-        pdu->setLastSn(rlcFragDesc.firstSn_ + rlcFragDesc.totalFragments_ - 1);
-        pdu->setSnoMainPacket(frameHeader->getSnoMainPacket());
-        pdu->setTxNumber(0);
-        fragment->insertAtFront(pdu);
-        EV_TRACE << "Created " << *fragment << " fragment.\n";
-        // prepare list of tx window indices
-        int txWindowIndex = tmp.seqNum_ - tmp.firstSeqNum_;
-        if(txWindowIndex>=200)
-            throw cRuntimeError("Illegal i");
-        windowsIndex.push_back(txWindowIndex);
-        fragment->copyTags(*frame);
-        fragments->push_back(fragment);
-        tmp.seqNum_++;
-    }
-    delete frame;
-    EV_TRACE << "Created " << fragments->size() << " fragments.\n";
-    return fragments;
-}
-
-
+    std::string name = std::string(currentSdu_->getName()) + "-frag" + std::to_string(index);
+    auto fragment = new Packet(name.c_str(), currentSdu_->peekDataAt(offset, length));
 
+    auto pdu = makeShared<LteRlcAmPdu>();
+    // set RLC type descriptor
+    pdu->setAmType(DATA);
+    // set fragmentation info
+    pdu->setTotalFragments(rlcFragDesc.totalFragments_);
+    pdu->setSnoFragment(rlcFragDesc.firstSn_ + index);
+    pdu->setFirstSn(rlcFragDesc.firstSn_);
+    pdu->setLastSn(rlcFragDesc.firstSn_ + rlcFragDesc.totalFragments_ - 1);
+    pdu->setSnoMainPacket(currentSdu_->peekAtFront<LteRlcAmSdu>()->getSnoMainPacket());
+    pdu->setTxNumber(0);
+    fragment->insertAtFront(pdu);
+    fragment->copyTags(*currentSdu_);
+
+    EV_TRACE << "Created " << *fragment << " fragment " << index + 1 << " of " << rlcFragDesc.totalFragments_ << ".\n";
+    return fragment;
+}
 
 void AmTxQueue::addPdus()
 {
@@ -152,7 +137,7 @@ void AmTxQueue::addPdus()
 
     while ((txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_) < txWindowDesc_.windowSize_)
     {
-        if (currentSdu_ == nullptr && sduQueue_.isEmpty() && (fragmentList_ == nullptr || fragmentList_->size() == 0))
+        if (currentSdu_ == nullptr && sduQueue_.isEmpty())
         {
             // No data to send
             EV << NOW << " AmTxQueue::addPdus - No data to send " << endl;
@@ -174,7 +159,6 @@ void AmTxQueue::addPdus()
                 fragDesc_.startFragmentation(pkt->getByteLength(), txWindowDesc_.seqNum_);
 
                 currentSdu_ = pkt;
-                fragmentList_ = fragmentFrame(pkt->dup(), txWindowIndexList_, fragDesc_);
 
                 // Starting Fragmentation
                 EV << NOW << " AmTxQueue::addPdus current SDU size "
@@ -192,23 +176,20 @@ void AmTxQueue::addPdus()
             }
         }
 
-        if (fragmentList_ == nullptr){
+        if (currentSdu_ == nullptr){
             // nothing more to do
             break;
         }
 
         EV << NOW << " AmTxQueue::addPdus - prepare new RLC PDU" << endl;
 
-        auto pdu = fragmentList_->front();
-        fragmentList_->pop_front();
-        auto txWindowIndex = txWindowIndexList_.front();
-        txWindowIndexList_.pop_front();
-
-        auto pduHeader = pdu->peekAtFront<LteRlcAmPdu>();
-
-        if (pduHeader->getSnoFragment() != txWindowDesc_.seqNum_)
+        // fragments are created one at a time, when they enter the transmission window
+        if ((unsigned int)(fragDesc_.firstSn_ + fragDesc_.fragCounter_) != txWindowDesc_.seqNum_)
             throw cRuntimeError("Pdu sequence numbers must be check");
 
+        auto pdu = makeFragment(fragDesc_);
+        int txWindowIndex = txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_;
+
         if (pduRtxQueue_.get(txWindowIndex) == nullptr)
         {
             // store a copy of current PDU
@@ -216,9 +197,6 @@ void AmTxQueue::addPdus()
             //pduCopy->setControlInfo(lteInfo->dup());
             pduRtxQueue_.addAt(txWindowIndex, pduCopy);
 
-            if(txWindowIndex>=200)
-                throw cRuntimeError("Illegal i");
-
             if (received_.at(txWindowIndex) || discarded_.at(txWindowIndex))
                 throw cRuntimeError("AmTxQueue::addPdus(): trying to add a PDU to a  position marked received [%d] discarded [%d]",
                     (int)(received_.at(txWindowIndex)) ,(int)(discarded_.at(txWindowIndex)));
@@ -231,11 +209,8 @@ void AmTxQueue::addPdus()
         pduTimer_.add(pduRtxTimeout_, txWindowDesc_.seqNum_);
 
         // Update number of added PDUs for the current SDU and check if all fragments have been transmitted
-        if (fragDesc_.addFragment() || (fragmentList_ && fragmentList_->empty()))
+        if (fragDesc_.addFragment())
         {
-            delete fragmentList_;
-            fragmentList_ = nullptr;
-            txWindowIndexList_.clear();
             fragDesc_.resetFragmentation();
             delete currentSdu_;
             currentSdu_ = nullptr;
@@ -253,8 +228,7 @@ void AmTxQueue::addPdus()
         // buffer (and send down) the PDU
         bufferPdu(pdu);
     }
-    ASSERT(fragmentList_ == nullptr);
-    ASSERT(txWindowIndexList_.empty());
+    ASSERT(currentSdu_ == nullptr);
     EV << NOW << " AmTxQueue::addPdus - added " << addedPdus << " PDUs" << endl;
 }
 
@@ -416,58 +390,11 @@ void AmTxQueue::moveTxWindow(const int seqNum)
             throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered empty PDU at location %d, shift position %d", i, pos);
     }
 
-    for (int i = pos;
-        i < ((txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_)); ++i)
-    {
-        if (pduRtxQueue_.get(i) != nullptr)
-        {
-            auto pdu = check_and_cast<Packet*>(pduRtxQueue_.remove(i));
-            pduRtxQueue_.addAt(i - pos, pdu);
-
-            EV << NOW << " AmTxQueue::moveTxWindow  PDU ["
-               << i + txWindowDesc_.firstSeqNum_
-               << "] corresponding index " << i
-               << " being moved at position " << i - pos << endl;
-        }
-        else
-        {
-            throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered empty PDU at location %d, shift position %d", i, pos);
-        }
-
-        EV << NOW << " AmTxQueue::moveTxWindow  PDU ["
-           << i + txWindowDesc_.firstSeqNum_
-           << "] corresponding new index " << i - pos
-           << " marked as received [" << (received_.at(i - pos))
-           << "] , discarded [" << (discarded_.at(i - pos)) << "]" << endl;
-
-        received_.at(i - pos) = received_.at(i);
-        discarded_.at(i - pos) = discarded_.at(i);
-
-        received_.at(i) = false;
-        discarded_.at(i) = false;
-
-        EV << NOW << " AmTxQueue::moveTxWindow  location [" << i
-           << "] corresponding new PDU "
-           << i + pos + txWindowDesc_.firstSeqNum_
-           << " marked as received [" << (received_.at(i))
-           << "] , discarded [" << (discarded_.at(i)) << "]" << endl;
-    }
-
-    // cleanup
-    for (int i = (txWindowDesc_.seqNum_ - txWindowDesc_.firstSeqNum_);
-        i < txWindowDesc_.windowSize_; ++i)
-    {
-        if (pduRtxQueue_.get(i) != nullptr)
-            throw cRuntimeError("AmTxQueue::moveTxWindow(): encountered busy PDU at location %d, shift position %d", i,
-                pos);
-
-        EV << NOW << " AmTxQueue::moveTxWindow  empty location [" << i
-           << "] marked as received [" << (received_.at(i))
-           << "] , discarded [" << (discarded_.at(i)) << "]" << endl;
-
-        received_.at(i) = false;
-        discarded_.at(i) = false;
-    }
+    // only the positions leaving the window are touched: the PDUs following them
+    // are not moved, and the positions entering the window are already reset
+    pduRtxQueue_.shift(pos);
+    received_.shift(pos, false);
+    discarded_.shift(pos, false);
 
     txWindowDesc_.firstSeqNum_ += pos;
 
@@ -736,9 +663,6 @@ void AmTxQueue::pduTimerHandle(const int sn)
 
     EV << NOW << " AmTxQueue::pduTimerHandle - sequence number " << sn << endl;
 
-    // signal event handling to timer
-    pduTimer_.handle(sn);
-
     // Some debug checks
     if ((index < 0) || (index >= txWindowDesc_.windowSize_))
         throw cRuntimeError(
@@ -780,7 +704,7 @@ void AmTxQueue::pduTimerHandle(const int sn)
         // The RLC PDU is added to the retransmission buffer
         pduPkt->insertAtFront(pduUpd);
         // add copy of the PDU to the rtx queue
-        pduRtxQueue_.add(pduPkt->dup());
+        pduRtxQueue_.addAt(index, pduPkt->dup());
         // Reschedule the timer
         pduTimer_.add(pduRtxTimeout_, sn);
         // send down the PDU
@@ -792,8 +716,6 @@ void AmTxQueue::mrwTimerHandle(const int sn)
 {
     EV << NOW << " AmTxQueue::mrwTimerHandle MRW_ACK sn: " << sn << endl;
 
-    mrwTimer_.handle(sn);
-
     if (mrwRtxQueue_.get(sn) == nullptr)
         throw cRuntimeError("MRW handler: MRW of SN %d not found in MRW message queue", sn);
 
@@ -824,40 +746,31 @@ void AmTxQueue::mrwTimerHandle(const int sn)
 
 void AmTxQueue::handleMessage(cMessage* msg)
 {
-    if (msg->isName("timer"))
+    if (timerWheel_.isTimerMessage(msg))
     {
-        // message received from a timer
-        TTimerMsg* tmsg = check_and_cast<TTimerMsg *>(msg);
-        // check timer id
-        RlcAmTimerType amType = static_cast<RlcAmTimerType>(tmsg->getTimerId());
-        TTimerType type = static_cast<TTimerType>(tmsg->getType());
-
-        switch (type)
+        // handle all the timer events expired at this time (the timer message is owned by the wheel)
+        unsigned int timerId, event;
+        while (timerWheel_.popExpired(timerId, event))
         {
-            case TTSIMPLE:
+            // check timer id
+            RlcAmTimerType amType = static_cast<RlcAmTimerType>(timerId);
+
+            if (amType == BUFFER_T)
+            {
                 // Check the buffer status and eventually send an MRW command.
                 checkForMrw();
-                // signal the timer the event has been handled
-                bufferStatusTimer_.handle();
-                break;
-            case TTMULTI:
-
-                TMultiTimerMsg* tmtmsg = check_and_cast<TMultiTimerMsg*>(tmsg);
-
-                if (amType == PDU_T)
-                {
-                    pduTimerHandle(tmtmsg->getEvent());
-                }
-                else if (amType == MRW_T)
-                {
-                    mrwTimerHandle(tmtmsg->getEvent());
-                }
-                else
-                    throw cRuntimeError("AmTxQueue::handleMessage(): unexpected timer event received");
-                break;
+            }
+            else if (amType == PDU_T)
+            {
+                pduTimerHandle(event);
+            }
+            else if (amType == MRW_T)
+            {
+                mrwTimerHandle(event);
+            }
+            else
+                throw cRuntimeError("AmTxQueue::handleMessage(): unexpected timer event received");
         }
-        // delete timer event message.
-        delete tmsg;
     }
     return;
 }
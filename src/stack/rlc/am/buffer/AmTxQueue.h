@@ -12,8 +12,9 @@
 
 #include "common/LteCommon.h"
 #include "common/LteControlInfo.h"
-#include "common/timer/TTimer.h"
+#include "common/timer/TTimerWheel.h"
 #include "stack/rlc/LteRlcDefs.h"
+#include "stack/rlc/LteRlcWindow.h"
 #include "stack/rlc/am/packet/LteRlcAmPdu.h"
 #include "stack/rlc/am/packet/LteRlcAmSdu_m.h"
 #include "stack/rlc/am/LteRlcAm.h"
@@ -45,8 +46,6 @@ class SIMULTE_API AmTxQueue : public cSimpleModule
      * SDU (upper layer PDU) currently being processed
      */
     Packet * currentSdu_ = nullptr;
-    std::deque<Packet *> *fragmentList_ = nullptr;
-    std::deque<int> txWindowIndexList_;
 
     /*
      * SDU Fragmentation descriptor
@@ -71,7 +70,7 @@ class SIMULTE_API AmTxQueue : public cSimpleModule
     /*
      * The PDU (fragments) buffer.
      */
-    cArray pduRtxQueue_;
+    RlcPduWindow pduRtxQueue_;
 
     /*
      * The MRW PDU retransmission buffer.
@@ -86,10 +85,10 @@ class SIMULTE_API AmTxQueue : public cSimpleModule
     //----------------------------------------------------------------------------------------
 
     // Received status variable
-    std::vector<bool> received_;
+    RlcRingWindow<bool> received_;
 
     // Discarded status variable
-    std::vector<bool> discarded_;
+    RlcRingWindow<bool> discarded_;
 
     // Transmission window descriptor
     RlcWindowDesc txWindowDesc_;
@@ -100,14 +99,17 @@ class SIMULTE_API AmTxQueue : public cSimpleModule
     //-------------------------------------------------------------------------
     //                Timers and Timeouts
     //-------------------------------------------------------------------------
+    // Timing wheel serving all the timers below, with a single timer message
+    TTimerWheel timerWheel_;
+
     // A multi-timer is kept to manage retransmissions and PDUs discard
-    TMultiTimer pduTimer_;
+    TWheelMultiTimer pduTimer_;
 
     // A multi-timer is kept to manage MRW control messages
-    TMultiTimer mrwTimer_;
+    TWheelMultiTimer mrwTimer_;
 
     // A Generic timer is used to analyze the buffer status
-    TTimer bufferStatusTimer_;
+    TWheelTimer bufferStatusTimer_;
 
     // maximum AM retransmissions
     int maxRtx_;
@@ -222,7 +224,11 @@ class SIMULTE_API AmTxQueue : public cSimpleModule
     void pduTimerHandle(const int sn);
     void mrwTimerHandle(const int sn);
 
-    std::deque<Packet *> * fragmentFrame(Packet *frame, std::deque<int>& windowsIndex, RlcFragDesc rlcFragDesc);
+    /*
+     * Create the next fragment of the current SDU, as described by the fragmentation
+     * descriptor. The fragment data is a slice of the SDU content, which is not copied
+     */
+    Packet * makeFragment(const RlcFragDesc& rlcFragDesc);
 };
 
 #endif
@@ -20,7 +20,7 @@ unsigned int UmRxEntity::totalCellPduRcvdBytes_ = 0;
 unsigned int UmRxEntity::totalCellRcvdBytes_ = 0;
 
 UmRxEntity::UmRxEntity() :
-    t_reordering_(this)
+    timerWheel_(this), t_reordering_(&timerWheel_)
 {
     t_reordering_.setTimerId(REORDERING_T);
     buffered_.pkt = nullptr;
@@ -223,19 +223,9 @@ void UmRxEntity::moveRxWindow(const int pos)
     if (pos>rxWindowDesc_.windowSize_)
         throw cRuntimeError("AmRxQueue::moveRxWindow(): positions %d win size %d ",pos,rxWindowDesc_.windowSize_);
 
-    for (unsigned int i = pos; i < rxWindowDesc_.windowSize_; ++i)
-    {
-        if (pduBuffer_.get(i) != nullptr)
-        {
-            pduBuffer_.addAt(i-pos, pduBuffer_.remove(i));
-        }
-        else
-        {
-            pduBuffer_.remove(i);
-        }
-        received_.at(i-pos) = received_.at(i);
-        received_.at(i) = false;
-    }
+    // only the positions leaving the window are touched
+    pduBuffer_.shift(pos);
+    received_.shift(pos, false);
 
     rxWindowDesc_.firstSno_ += pos;
 
@@ -720,6 +710,9 @@ void UmRxEntity::initialize()
     timeout_ = par("timeout").doubleValue();
     rxWindowDesc_.clear();
     rxWindowDesc_.windowSize_ = par("rxWindowSize");
+    if (rxWindowDesc_.windowSize_ == 0 || rxWindowDesc_.windowSize_ > RLC_MAX_WINDOW_SIZE)
+        throw cRuntimeError("UmRxEntity::initialize(): invalid rxWindowSize %d", rxWindowDesc_.windowSize_);
+    pduBuffer_.resize(rxWindowDesc_.windowSize_);
     received_.resize(rxWindowDesc_.windowSize_);
 
     totalRcvdBytes_ = 0;
@@ -778,10 +771,10 @@ void UmRxEntity::initialize()
 
 void UmRxEntity::handleMessage(cMessage* msg)
 {
-    if (msg->isName("timer"))
+    // the timer message is owned by the wheel
+    unsigned int timerId, event;
+    while (timerWheel_.isTimerMessage(msg) && timerWheel_.popExpired(timerId, event))
     {
-        t_reordering_.handle();
-
         EV << NOW << " UmRxEntity::handleMessage : t_reordering timer has expired " << endl;
 
         unsigned int old = rxWindowDesc_.firstSnoForReordering_;
@@ -807,9 +800,6 @@ void UmRxEntity::handleMessage(cMessage* msg)
             rxWindowDesc_.reorderingSno_ = rxWindowDesc_.highestReceivedSno_;
             t_reordering_.start(timeout_);
         }
-
-        delete msg;
-
     }
 }
 
@@ -12,10 +12,11 @@
 
 #include <omnetpp.h>
 #include "stack/rlc/um/LteRlcUm.h"
-#include "common/timer/TTimer.h"
+#include "common/timer/TTimerWheel.h"
 #include "common/LteControlInfo.h"
 #include "stack/pdcp_rrc/packet/LtePdcpPdu_m.h"
 #include "stack/rlc/LteRlcDefs.h"
+#include "stack/rlc/LteRlcWindow.h"
 
 class LteMacBase;
 class LteRlcUm;
@@ -101,19 +102,22 @@ class SIMULTE_API UmRxEntity : public omnetpp::cSimpleModule
     FlowControlInfo* flowControlInfo_;
 
     // The PDU enqueue buffer.
-    omnetpp::cArray pduBuffer_;
+    RlcPduWindow pduBuffer_;
 
     // State variables
     RlcUmRxWindowDesc rxWindowDesc_;
 
+    // Timing wheel serving the timer below
+    TTimerWheel timerWheel_;
+
     // Timer to manage reordering of the PDUs
-    TTimer t_reordering_;
+    TWheelTimer t_reordering_;
 
     // Timeout for above timer
     double timeout_;
 
     // For each PDU a received status variable is kept.
-    std::vector<bool> received_;
+    RlcRingWindow<bool> received_;
 
     // The SDU waiting for the missing portion
     struct Buffered {
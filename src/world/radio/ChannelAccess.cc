@@ -101,6 +101,13 @@ IChannelControl *ChannelAccess::getChannelControl()
     return cc;
 }
 
+void ChannelAccess::getRadiosInRange(std::vector<cModule*>& radios)
+{
+    const std::vector<IChannelControl::RadioRef>& neighbors = cc->getNeighbors(myRadioRef);
+    for (unsigned int i = 0; i < neighbors.size(); i++)
+        radios.push_back(cc->getRadioModule(neighbors[i]));
+}
+
 /**
  * This function has to be called whenever a packet is supposed to be
  * sent to the channel.
@@ -73,6 +73,9 @@ class SIMULTE_API ChannelAccess : public omnetpp::cSimpleModule, public omnetpp:
     /** Finds the channelControl module in the network */
     IChannelControl *getChannelControl();
 
+    /** Appends to the given vector the modules of the radios in range of this one */
+    void getRadiosInRange(std::vector<omnetpp::cModule*>& radios);
+
   protected:
     /** Sends a message to all radios in range */
     virtual void sendToChannel(AirFrame *msg);
@@ -15,6 +15,7 @@
  **************************************************************************/
 
 #include <cassert>
+#include <algorithm>
 
 #include <inet/common/INETMath.h>
 
@@ -25,6 +26,35 @@ Define_Module(ChannelControl);
 
 using namespace omnetpp;
 
+// grid cell coordinates are packed into 21 bits each
+#define CELL_BITS 21
+#define CELL_OFFSET (1 << (CELL_BITS - 1))
+#define CELL_MASK ((1 << CELL_BITS) - 1)
+
+static int64_t packCell(double x, double y, double z)
+{
+    // coordinates out of the representable range are clamped: the cells at the border
+    // then cover a wider area, which is only less efficient
+    double c[3] = { x, y, z };
+    int64_t key = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        if (!(c[i] > -CELL_OFFSET))
+            c[i] = -CELL_OFFSET;
+        else if (c[i] > CELL_OFFSET - 1)
+            c[i] = CELL_OFFSET - 1;
+        key = (key << CELL_BITS) | ((int64_t)c[i] + CELL_OFFSET);
+    }
+    return key;
+}
+
+static void unpackCell(int64_t key, int64_t& x, int64_t& y, int64_t& z)
+{
+    z = (key & CELL_MASK) - CELL_OFFSET;
+    y = ((key >> CELL_BITS) & CELL_MASK) - CELL_OFFSET;
+    x = ((key >> (2 * CELL_BITS)) & CELL_MASK) - CELL_OFFSET;
+}
+
 std::ostream& operator<<(std::ostream& os, const ChannelControl::RadioEntry& radio)
 {
     os << radio.radioModule->getFullPath() << " (x=" << radio.pos.x << ",y=" << radio.pos.y << "), "
@@ -41,6 +71,8 @@ std::ostream& operator<<(std::ostream& os, const ChannelControl::TransmissionLis
 
 ChannelControl::ChannelControl()
 {
+    cellSize = 0;
+    markStamp = 0;
 }
 
 ChannelControl::~ChannelControl()
@@ -68,6 +100,9 @@ void ChannelControl::initialize()
 
     maxInterferenceDistance = calcInterfDist();
 
+    // with an unbounded interference distance, all the radios are in the same cell
+    cellSize = (std::isfinite(maxInterferenceDistance) && maxInterferenceDistance > 0) ? maxInterferenceDistance : 0;
+
     WATCH(maxInterferenceDistance);
     WATCH_LIST(radios);
     WATCH_VECTOR(transmissions);
@@ -124,8 +159,12 @@ ChannelControl::RadioRef ChannelControl::registerRadio(cModule *radio, cGate *ra
     re.isNeighborListValid = false;
     re.channel = 0;  // for now
     re.isActive = true;
+    re.mark = 0;
     radios.push_back(re);
-    return &radios.back(); // last element
+
+    RadioRef newRadio = &radios.back(); // last element
+    addToCell(newRadio);
+    return newRadio;
 }
 
 void ChannelControl::unregisterRadio(RadioRef r)
@@ -136,14 +175,10 @@ void ChannelControl::unregisterRadio(RadioRef r)
         if (it->radioModule == r->radioModule)
         {
             RadioRef radioToRemove = &*it;
-            // erase radio from all registered radios' neighbor list
-            for (RadioList::iterator i2 = radios.begin(); i2 != radios.end(); ++i2)
-            {
-                RadioRef otherRadio = &*i2;
-                otherRadio->neighbors.erase(radioToRemove);
-                otherRadio->isNeighborListValid = false;
-                radioToRemove->isNeighborListValid = false;
-            }
+            // erase radio from its neighbors' neighbor list
+            for (unsigned int i = 0; i < radioToRemove->neighbors.size(); i++)
+                removeNeighbor(radioToRemove->neighbors[i], radioToRemove);
+            removeFromCell(radioToRemove);
 
             // erase radio from registered radios
             radios.erase(it);
@@ -168,43 +203,123 @@ const ChannelControl::RadioRefVector& ChannelControl::getNeighbors(RadioRef h)
     Enter_Method_Silent();
     if (!h->isNeighborListValid)
     {
-        h->neighborList.clear();
-        for (std::set<RadioRef,RadioEntry::Compare>::iterator it = h->neighbors.begin(); it != h->neighbors.end(); it++)
-            h->neighborList.push_back(*it);
+        h->neighborList = h->neighbors;
+        std::sort(h->neighborList.begin(), h->neighborList.end(), RadioEntry::Compare());
         h->isNeighborListValid = true;
     }
     return h->neighborList;
 }
 
+int64_t ChannelControl::getCell(const inet::Coord& pos) const
+{
+    if (cellSize == 0)
+        return 0;
+    return packCell(floor(pos.x / cellSize), floor(pos.y / cellSize), floor(pos.z / cellSize));
+}
+
+void ChannelControl::addToCell(RadioRef h)
+{
+    h->cell = getCell(h->pos);
+    RadioRefVector& cellRadios = cells[h->cell];
+    h->cellIndex = cellRadios.size();
+    cellRadios.push_back(h);
+}
+
+void ChannelControl::removeFromCell(RadioRef h)
+{
+    CellMap::iterator it = cells.find(h->cell);
+    ASSERT(it != cells.end() && it->second[h->cellIndex] == h);
+
+    RadioRefVector& cellRadios = it->second;
+    RadioRef last = cellRadios.back();
+    cellRadios[h->cellIndex] = last;
+    last->cellIndex = h->cellIndex;
+    cellRadios.pop_back();
+    if (cellRadios.empty())
+        cells.erase(it);
+}
+
+void ChannelControl::removeNeighbor(RadioRef h, RadioRef r)
+{
+    RadioRefVector::iterator it = std::find(h->neighbors.begin(), h->neighbors.end(), r);
+    if (it == h->neighbors.end())
+        return;
+    *it = h->neighbors.back();
+    h->neighbors.pop_back();
+    h->isNeighborListValid = false;
+}
+
 void ChannelControl::updateConnections(RadioRef h)
 {
+    // move the radio to its new cell, if it changed
+    if (getCell(h->pos) != h->cell)
+    {
+        removeFromCell(h);
+        addToCell(h);
+    }
+
+    if (++markStamp == 0)
+    {
+        // the stamp wrapped around: reset all marks
+        for (RadioList::iterator it = radios.begin(); it != radios.end(); ++it)
+            it->mark = 0;
+        markStamp = 1;
+    }
+
     inet::Coord& hpos = h->pos;
     double maxDistSquared = maxInterferenceDistance * maxInterferenceDistance;
-    for (RadioList::iterator it = radios.begin(); it != radios.end(); ++it)
+
+    // out of range: disconnect. Neighbors still in range are marked, so that
+    // they are not connected again below
+    // (omitting the square root (calling sqrdist() instead of distance()) saves about 5% CPU)
+    for (unsigned int i = 0; i < h->neighbors.size();)
     {
-        RadioEntry *hi = &(*it);
-        if (hi == h)
+        RadioRef hi = h->neighbors[i];
+        if (hpos.sqrdist(hi->pos) < maxDistSquared)
+        {
+            hi->mark = markStamp;
+            i++;
             continue;
+        }
+        h->neighbors[i] = h->neighbors.back();
+        h->neighbors.pop_back();
+        removeNeighbor(hi, h);
+        h->isNeighborListValid = false;
+    }
 
-        // get the distance between the two radios.
-        // (omitting the square root (calling sqrdist() instead of distance()) saves about 5% CPU)
-        bool inRange = hpos.sqrdist(hi->pos) < maxDistSquared;
+    // nodes within communication range: connect. Radios in range can only be in the
+    // cells adjacent to the one of h
+    int64_t cellKeys[27];
+    int numCells = 0;
+    if (cellSize == 0)
+        cellKeys[numCells++] = h->cell;
+    else
+    {
+        int64_t cx, cy, cz;
+        unpackCell(h->cell, cx, cy, cz);
+        for (int dx = -1; dx <= 1; dx++)
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dz = -1; dz <= 1; dz++)
+                    cellKeys[numCells++] = packCell(cx + dx, cy + dy, cz + dz);
+    }
 
-        if (inRange)
-        {
-            // nodes within communication range: connect
-            if (h->neighbors.insert(hi).second == true)
-            {
-                hi->neighbors.insert(h);
-                h->isNeighborListValid = hi->isNeighborListValid = false;
-            }
-        }
-        else
+    for (int c = 0; c < numCells; c++)
+    {
+        CellMap::iterator it = cells.find(cellKeys[c]);
+        if (it == cells.end())
+            continue;
+
+        const RadioRefVector& cellRadios = it->second;
+        for (unsigned int i = 0; i < cellRadios.size(); i++)
         {
-            // out of range: disconnect
-            if (h->neighbors.erase(hi))
+            RadioRef hi = cellRadios[i];
+            if (hi == h || hi->mark == markStamp)
+                continue;
+            if (hpos.sqrdist(hi->pos) < maxDistSquared)
             {
-                hi->neighbors.erase(h);
+                h->neighbors.push_back(hi);
+                hi->neighbors.push_back(h);
+                hi->mark = markStamp;
                 h->isNeighborListValid = hi->isNeighborListValid = false;
             }
         }
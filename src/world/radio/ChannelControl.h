@@ -19,7 +19,7 @@
 
 #include <vector>
 #include <list>
-#include <set>
+#include <unordered_map>
 
 #include <inet/common/INETDefs.h>
 #include <inet/common/geometry/common/Coord.h>
@@ -48,11 +48,16 @@ struct IChannelControl::RadioEntry {
             return lhs->radioModule->getId() < rhs->radioModule->getId();
         }
     };
-    // we cache neighbors set in an std::vector, because std::set iteration is slow;
-    // std::vector is created and updated on demand
-    std::set<RadioRef, Compare> neighbors; // cached neighbor list
+    // neighbors are kept unordered in a flat vector, updated incrementally on position changes;
+    // the list returned by getNeighbors() is a copy sorted by module id, rebuilt on demand
+    std::vector<RadioRef> neighbors; // cached neighbor list
     std::vector<RadioRef> neighborList;
     bool isNeighborListValid;
+    // grid cell the radio is in, and position within the cell's radio vector
+    int64_t cell;
+    unsigned int cellIndex;
+    // used by updateConnections() to mark the current neighbors
+    unsigned int mark;
     bool isActive;
 };
 
@@ -92,9 +97,35 @@ class SIMULTE_API ChannelControl : public omnetpp::cSimpleModule, public IChanne
     /** the number of controlled channels */
     int numChannels;
 
+    /**
+     * Radios are hashed on a uniform grid whose cells have the size of the interference
+     * distance, so that only the radios in the adjacent cells have to be checked when a
+     * radio moves. Cells are identified by their packed coordinates
+     */
+    typedef std::unordered_map<int64_t, RadioRefVector> CellMap;
+    CellMap cells;
+
+    /** side of the grid cells (0 if the whole space is a single cell) */
+    double cellSize;
+
+    /** stamp used to mark the neighbors of the radio being updated */
+    unsigned int markStamp;
+
   protected:
     virtual void updateConnections(RadioRef h);
 
+    /** Returns the grid cell containing the given position */
+    virtual int64_t getCell(const inet::Coord& pos) const;
+
+    /** Puts the radio in the grid cell of its current position */
+    virtual void addToCell(RadioRef h);
+
+    /** Removes the radio from its grid cell */
+    virtual void removeFromCell(RadioRef h);
+
+    /** Removes r from the neighbors of h */
+    virtual void removeNeighbor(RadioRef h, RadioRef r);
+
     /** Calculate interference distance*/
     virtual double calcInterfDist();
 
@@ -107,9 +138,6 @@ class SIMULTE_API ChannelControl : public omnetpp::cSimpleModule, public IChanne
     /** Validate the channel identifier */
     virtual void checkChannel(int channel);
 
-    /** Get the list of modules in range of the given host */
-    virtual const RadioRefVector& getNeighbors(RadioRef h);
-
     /** Notifies the channel control with an ongoing transmission */
     virtual void addOngoingTransmission(RadioRef h, AirFrame *frame);
 
@@ -150,6 +178,9 @@ class SIMULTE_API ChannelControl : public omnetpp::cSimpleModule, public IChanne
     /** Called from ChannelAccess, to transmit a frame to the radios in range, on the frame's channel */
     virtual void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) override;
 
+    /** Get the list of modules in range of the given host */
+    virtual const RadioRefVector& getNeighbors(RadioRef h) override;
+
     /** Returns the maximal interference distance*/
     virtual double getInterferenceRange(RadioRef r) override { return maxInterferenceDistance; }
 
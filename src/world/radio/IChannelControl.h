@@ -72,6 +72,9 @@ class SIMULTE_API IChannelControl
     /** Called from ChannelAccess, to transmit a frame to the radios in range, on the frame's channel */
     virtual void sendToChannel(RadioRef srcRadio, AirFrame *airFrame) = 0;
 
+    /** Returns the radios within interference distance of the given one */
+    virtual const std::vector<RadioRef>& getNeighbors(RadioRef r) = 0;
+
     /** Returns the maximal interference distance*/
     virtual double getInterferenceRange(RadioRef r) = 0;
 
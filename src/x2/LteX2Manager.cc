@@ -22,12 +22,25 @@ Define_Module(LteX2Manager);
 using namespace omnetpp;
 using namespace inet;
 
+LteX2Manager::~LteX2Manager()
+{
+    std::map<X2NodeId, PendingX2Messages>::iterator it;
+    for (it = pendingMsgs_.begin(); it != pendingMsgs_.end(); ++it)
+        cancelAndDelete(it->second.timer);
+}
+
 void LteX2Manager::initialize(int stage)
 {
     if (stage == inet::INITSTAGE_LOCAL)
     {
         // get the node id
         nodeId_ = getAncestorPar("macCellId");
+
+        aggregation_ = par("aggregation").boolValue();
+        aggregationWindow_ = par("aggregationWindow");
+
+        x2AggregatedMsgs_ = registerSignal("x2AggregatedMsgs");
+        x2MsgsSaved_ = registerSignal("x2MsgsSaved");
     }
     else if (stage == inet::INITSTAGE_NETWORK_LAYER)
     {
@@ -73,6 +86,13 @@ void LteX2Manager::initialize(int stage)
 
 void LteX2Manager::handleMessage(cMessage *msg)
 {
+    if (msg->isSelfMessage())
+    {
+        // the aggregation window for a peer has expired
+        sendAggregatedMsg(*static_cast<PendingX2Messages*>(msg->getContextPointer()));
+        return;
+    }
+
     Packet* pkt = check_and_cast<Packet*>(msg);
     cGate* incoming = pkt->getArrivalGate();
 
@@ -124,27 +144,104 @@ void LteX2Manager::fromStack(Packet* pkt)
     for (; it != destList.end(); ++it)
     {
         X2NodeId targetEnb = *it;
+
+        // control messages without payload can be aggregated with the other messages for the same peer
+        if (aggregation_ && x2msg->getType() != X2_HANDOVER_DATA_MSG && pkt->getDataLength() == b(0))
+        {
+            auto msgCopy = staticPtrCast<LteX2Message>(x2msg->dupShared());
+            msgCopy->setSourceId(nodeId_);
+            msgCopy->setDestinationId(targetEnb);
+
+            std::map<X2NodeId, PendingX2Messages>::iterator pit = pendingMsgs_.find(targetEnb);
+            if (pit == pendingMsgs_.end())
+            {
+                PendingX2Messages newPending;
+                newPending.peerId = targetEnb;
+                newPending.timer = nullptr;
+                pit = pendingMsgs_.insert(std::make_pair(targetEnb, newPending)).first;
+                pit->second.timer = new cMessage("x2AggregationTimer");
+                pit->second.timer->setContextPointer(&pit->second);
+                // with a zero window, the timer must fire after the other events at the current time
+                pit->second.timer->setSchedulingPriority(1);
+            }
+            if (pit->second.msgs.empty())
+                scheduleAt(NOW + aggregationWindow_, pit->second.timer);
+            pit->second.msgs.push_back(msgCopy);
+            continue;
+        }
+
         auto pktDuplicate = pkt->dup();
         x2msg->markMutableIfExclusivelyOwned();
         x2msg->setSourceId(nodeId_);
         x2msg->setDestinationId(targetEnb);
         pktDuplicate->insertAtFront(x2msg);
 
-        cGate* outputGate;
         if(x2msg->getType() == X2_HANDOVER_DATA_MSG){
             // send to the gate connected to the GTPUser module
-            outputGate = gate("x2Gtp$o");
+            send(pktDuplicate, gate("x2Gtp$o"));
         } else {
-            // select the index for the output gate (it belongs to a vector)
-            int gateIndex = x2InterfaceTable_[*it];
-            outputGate = gate("x2$o",gateIndex);
+            sendToPeer(pktDuplicate, targetEnb);
         }
-        send(pktDuplicate, outputGate);
     }
     //delete x2Info;
     delete pkt;
 }
 
+void LteX2Manager::sendToPeer(Packet* pkt, X2NodeId peerId)
+{
+    // select the index for the output gate (it belongs to a vector)
+    int gateIndex = x2InterfaceTable_[peerId];
+    send(pkt, gate("x2$o",gateIndex));
+}
+
+void LteX2Manager::sendAggregatedMsg(PendingX2Messages& pending)
+{
+    if (pending.timer->isScheduled())
+        cancelEvent(pending.timer);
+    if (pending.msgs.empty())
+        return;
+
+    Packet* pkt;
+    if (pending.msgs.size() == 1)
+    {
+        pkt = new Packet("LteX2Message");
+        pkt->insertAtFront(pending.msgs.front());
+    }
+    else
+    {
+        EV << "LteX2Manager::sendAggregatedMsg - aggregating " << pending.msgs.size() << " X2 messages for peer " << pending.peerId << endl;
+
+        // the header is followed by the aggregated messages, in the order they were sent
+        auto header = makeShared<LteX2Message>();
+        header->setType(X2_AGGREGATED_MSG);
+        header->setSourceId(nodeId_);
+        header->setDestinationId(pending.peerId);
+
+        pkt = new Packet("X2AggregatedMsg");
+        pkt->insertAtBack(header);
+        for (unsigned int i = 0; i < pending.msgs.size(); i++)
+            pkt->insertAtBack(pending.msgs[i]);
+
+        emit(x2AggregatedMsgs_, (long)pending.msgs.size());
+        emit(x2MsgsSaved_, (long)pending.msgs.size() - 1);
+    }
+    pkt->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::x2ap);
+    sendToPeer(pkt, pending.peerId);
+
+    pending.msgs.clear();
+}
+
+void LteX2Manager::sendToStack(Packet* pkt, LteX2MessageType msgType)
+{
+    // get the correct output gate for the message
+    int gateIndex = dataInterfaceTable_[msgType];
+    cGate* outGate = gate(DATAPORT_OUT, gateIndex);
+
+    // send X2 msg to stack
+    EV << "LteX2Manager::sendToStack - send X2MSG to LTE stack" << endl;
+    send(pkt, outGate);
+}
+
 void LteX2Manager::fromX2(Packet* pkt)
 {
     auto x2msg = pkt->peekAtFront<LteX2Message>();
@@ -156,11 +253,20 @@ void LteX2Manager::fromX2(Packet* pkt)
         return;
     }
 
-    // get the correct output gate for the message
-    int gateIndex = dataInterfaceTable_[msgType];
-    cGate* outGate = gate(DATAPORT_OUT, gateIndex);
+    if (msgType == X2_AGGREGATED_MSG)
+    {
+        // dispatch each aggregated message to its X2 user module, in order
+        pkt->popAtFront<LteX2Message>();
+        while (pkt->getDataLength() > b(0))
+        {
+            auto msg = pkt->popAtFront<LteX2Message>();
+            Packet* msgPkt = new Packet("LteX2Message", msg);
+            msgPkt->addTagIfAbsent<PacketProtocolTag>()->setProtocol(&LteProtocol::x2ap);
+            sendToStack(msgPkt, msg->getType());
+        }
+        delete pkt;
+        return;
+    }
 
-    // send X2 msg to stack
-    EV << "LteX2Manager::fromX2 - send X2MSG to LTE stack" << endl;
-    send(pkt, outGate);
+    sendToStack(pkt, msgType);
 }
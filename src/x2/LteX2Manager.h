@@ -33,6 +33,41 @@ class SIMULTE_API LteX2Manager : public omnetpp::cSimpleModule {
     // where the X2AP for that destination is connected to
     std::map<X2NodeId, int> x2InterfaceTable_;
 
+    /*
+     * Aggregation of X2 control messages: the messages sent to the same peer within the
+     * aggregation window are carried by a single X2 message, and dispatched one by one to
+     * the X2 user modules on receipt. Data messages are never aggregated
+     */
+    bool aggregation_;
+    omnetpp::simtime_t aggregationWindow_;
+
+    struct PendingX2Messages
+    {
+        X2NodeId peerId;
+        std::vector<inet::Ptr<LteX2Message> > msgs;
+        omnetpp::cMessage* timer;
+    };
+
+    // messages waiting to be aggregated, for each peer
+    std::map<X2NodeId, PendingX2Messages> pendingMsgs_;
+
+    // statistics
+    omnetpp::simsignal_t x2AggregatedMsgs_;
+    omnetpp::simsignal_t x2MsgsSaved_;
+
+    // send the pending messages for a peer within a single X2 message
+    void sendAggregatedMsg(PendingX2Messages& pending);
+
+    // send the given X2 message to the X2App connected to the given peer
+    void sendToPeer(inet::Packet* pkt, X2NodeId peerId);
+
+    // send the given X2 message to the X2 user module handling its type
+    void sendToStack(inet::Packet* pkt, LteX2MessageType msgType);
+
+public:
+    LteX2Manager() : aggregation_(false) {}
+    virtual ~LteX2Manager();
+
 protected:
 
     void initialize(int stage) override;
@@ -21,6 +21,7 @@
 #include "stack/compManager/compManagerProportional/X2CompProportionalRequestIE.h"
 #include "stack/compManager/compManagerProportional/X2CompProportionalReplyIE.h"
 #include "stack/handoverManager/X2HandoverCommandIE.h"
+#include "stack/handoverManager/X2HandoverDataBatchIE.h"
 #include "inet/common/packet/serializer/ChunkSerializerRegistry.h"
 
 using namespace inet;
@@ -34,6 +35,7 @@ Register_Serializer(LteX2Message, LteX2MsgSerializer);
  * X2_COMP_MSG  (class X2CompMsg)
  * X2_HANDOVER_CONTROL_MSG  (class X2HandoverControlMsg)
  * X2_HANDOVER_DATA_MSG  (class X2HandoverDataMsg)
+ * X2_AGGREGATED_MSG  (class LteX2Message, followed by the aggregated messages)
  */
 
 void LteX2MsgSerializer::serialize(MemoryOutputStream& stream, const Ptr<const Chunk>& chunk) const
@@ -41,7 +43,7 @@ void LteX2MsgSerializer::serialize(MemoryOutputStream& stream, const Ptr<const C
     auto startPosition = stream.getLength();
     const auto& msg = staticPtrCast<const LteX2Message>(chunk);
     LteX2MessageType type = msg->getType();
-    if(type != X2_COMP_MSG && type != X2_HANDOVER_CONTROL_MSG && type != X2_HANDOVER_DATA_MSG)
+    if(type != X2_COMP_MSG && type != X2_HANDOVER_CONTROL_MSG && type != X2_HANDOVER_DATA_MSG && type != X2_AGGREGATED_MSG)
         throw cRuntimeError("LteX2MsgSerializer::serialize of X2 message type is not implemented!");
 
     stream.writeByte(type);
@@ -78,6 +80,13 @@ void LteX2MsgSerializer::serialize(MemoryOutputStream& stream, const Ptr<const C
             stream.writeUint16Be(handoverCmd->getUeId());
             break;
         }
+        case X2_HANDOVER_DATA_BATCH_IE: {
+            X2HandoverDataBatchIE* dataBatch = check_and_cast<X2HandoverDataBatchIE*>(ie);
+            stream.writeUint16Be(dataBatch->getNumDatagrams());
+            for (unsigned int i = 0; i < dataBatch->getNumDatagrams(); i++)
+                stream.writeUint32Be(dataBatch->getDatagramLength(i));
+            break;
+        }
         default:
             throw cRuntimeError("LteX2MsgSerializer::serialize of this X2InformationElement not implemented!");
         }
@@ -114,6 +123,10 @@ const Ptr<Chunk> LteX2MsgSerializer::deserialize(MemoryInputStream& stream) cons
     case X2_HANDOVER_DATA_MSG:
         msg = makeShared<X2HandoverDataMsg>();
         break;
+    case X2_AGGREGATED_MSG:
+        msg = makeShared<LteX2Message>();
+        msg->setType(X2_AGGREGATED_MSG);
+        break;
     default:
         throw cRuntimeError("LteX2MsgSerializer::deserialize of X2 message type ist not implemented!");
     }
@@ -152,6 +165,14 @@ const Ptr<Chunk> LteX2MsgSerializer::deserialize(MemoryInputStream& stream) cons
             ie = handoverCmd;
             break;
         }
+        case X2_HANDOVER_DATA_BATCH_IE: {
+            auto dataBatch = new X2HandoverDataBatchIE();
+            uint16_t numDatagrams = stream.readUint16Be();
+            for (uint16_t j = 0; j < numDatagrams; j++)
+                dataBatch->addDatagram(stream.readUint32Be(), "");
+            ie = dataBatch;
+            break;
+        }
         default:
             throw cRuntimeError("LteX2MsgSerializer::serialize for X2InformationElement type not implemented!");
         }
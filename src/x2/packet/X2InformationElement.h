@@ -20,7 +20,8 @@ enum X2InformationElementType
     COMP_REPLY_IE,           // CoMP master -> slave
     COMP_PROP_REQUEST_IE,    // CoMP slave -> master (for compManagerProportional, with RB value)
     COMP_PROP_REPLY_IE,      // CoMP master -> slave (for compManagerProportional, with map)
-    X2_HANDOVER_CMD_IE       // HO command source eNB -> target eNB
+    X2_HANDOVER_CMD_IE,      // HO command source eNB -> target eNB
+    X2_HANDOVER_DATA_BATCH_IE  // HO data source eNB -> target eNB (several datagrams in one message)
 };
 
 //